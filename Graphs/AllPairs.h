@@ -0,0 +1,195 @@
+#ifndef GRAPHS_ALLPAIRS_H
+#define GRAPHS_ALLPAIRS_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include "CsrGraph.h"
+#include "Parallel.h"
+#include "ThreadPool.h"
+#include "ShortestPaths.h"
+
+/**
+ * Матрица кратчайших расстояний между всеми парами вершин, хранится по строкам в одном массиве.
+ * Бесконечность для целых расстояний - половина максимального значения, поэтому сумма двух расстояний
+ * не переполняется и алгоритм Флойда-Уоршелла обходится без проверок.
+ * @tparam Distance тип расстояния.
+ */
+template<typename Distance>
+struct DistanceMatrix  {
+    // Расстояние до недостижимой вершины.
+    static constexpr Distance kInfinity = std::is_floating_point_v<Distance> ? std::numeric_limits<Distance>::infinity()
+                                                                             : std::numeric_limits<Distance>::max() / 2;
+    // Количество вершин.
+    size_t verts = 0;
+    // Расстояния, distances[from * verts + to].
+    std::vector<Distance> distances;
+
+    // Расстояние от from до to.
+    Distance operator()(size_t from, size_t to) const  {
+        return distances[from * verts + to];
+    }
+    // Есть ли путь из from в to.
+    [[nodiscard]] bool Reachable(size_t from, size_t to) const  {
+        return distances[from * verts + to] != kInfinity;
+    }
+    /**
+     * Матрица длин дуг графа: 0 на диагонали, длина самой короткой из параллельных дуг, бесконечность, если дуги нет.
+     * @param graph граф в представлении CSR.
+     * @return матрица длин дуг.
+     */
+    template<typename Vertex, typename Weight, bool Directed>
+    static DistanceMatrix FromCsr(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+        DistanceMatrix matrix;
+        matrix.verts = graph.Verts();
+        matrix.distances.assign(matrix.verts * matrix.verts, kInfinity);
+        for (size_t v = 0; v < matrix.verts; ++v)  {
+            matrix.distances[v * matrix.verts + v] = 0;
+            for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+                Distance& distance = matrix.distances[v * matrix.verts + graph.targets[arc]];
+                distance = std::min(distance, Distance(graph.WeightOf(arc)));
+            }
+        }
+        return matrix;
+    }
+};
+
+// Сторона квадратного блока матрицы в алгоритме Флойда-Уоршелла: три блока помещаются в кэш L1/L2.
+constexpr size_t kFloydTile = 64;
+
+/**
+ * Пересчет отрезка строки через промежуточную вершину: row[j] = min(row[j], toK + through[j]).
+ * Строки не пересекаются, о чем компилятор узнает из __restrict, поэтому цикл векторизуется без проверок (при -O3).
+ */
+template<typename Distance>
+void MinPlusRow(Distance* __restrict row, const Distance* __restrict through, Distance toK, size_t begin, size_t end)  {
+    for (size_t j = begin; j < end; ++j)  {
+        row[j] = std::min(row[j], toK + through[j]);
+    }
+}
+
+/**
+ * Шаг алгоритма Флойда-Уоршелла для одного блока: пересчет блока (rows, cols) через вершины блока ks.
+ * Внутренний цикл - поэлементный минимум двух непрерывных строк без ветвлений, который компилятор векторизует.
+ * Строка самой промежуточной вершины пропускается: расстояние от нее до себя 0, и строка бы не изменилась.
+ * @param matrix матрица расстояний.
+ * @param rows, cols, ks номера блоков строк, столбцов и промежуточных вершин.
+ */
+template<typename Distance>
+void FloydTile(DistanceMatrix<Distance>& matrix, size_t rows, size_t cols, size_t ks)  {
+    size_t n = matrix.verts;
+    size_t rowEnd = std::min(n, (rows + 1) * kFloydTile), colBegin = cols * kFloydTile;
+    size_t colEnd = std::min(n, colBegin + kFloydTile), kEnd = std::min(n, (ks + 1) * kFloydTile);
+    Distance* d = matrix.distances.data();
+    for (size_t k = ks * kFloydTile; k < kEnd; ++k)  {
+        const Distance* through = d + k * n;
+        for (size_t i = rows * kFloydTile; i < rowEnd; ++i)  {
+            Distance toK = d[i * n + k];
+            if (i != k && toK != DistanceMatrix<Distance>::kInfinity)  {
+                MinPlusRow(d + i * n, through, toK, colBegin, colEnd);
+            }
+        }
+    }
+}
+
+/**
+ * Блочный алгоритм Флойда-Уоршелла. Для каждого блока промежуточных вершин сначала пересчитывается
+ * диагональный блок, затем параллельно блоки его строки и столбца, затем параллельно все остальные блоки.
+ * Каждый блок на своем этапе читает только уже пересчитанные блоки, поэтому этапы не требуют синхронизации внутри.
+ * @param matrix матрица длин дуг, на выходе - матрица расстояний.
+ */
+template<typename Distance>
+void FloydWarshall(DistanceMatrix<Distance>& matrix)  {
+    size_t tiles = (matrix.verts + kFloydTile - 1) / kFloydTile;
+    for (size_t k = 0; k < tiles; ++k)  {
+        FloydTile(matrix, k, k, k);
+        TaskGroup cross;
+        for (size_t t = 0; t < tiles; ++t)  {
+            if (t != k)  {
+                cross.Spawn([&matrix, t, k]  {
+                    FloydTile(matrix, k, t, k);
+                    FloydTile(matrix, t, k, k);
+                });
+            }
+        }
+        cross.Wait();
+        TaskGroup rest;
+        for (size_t i = 0; i < tiles; ++i)  {
+            if (i == k)  {
+                continue;
+            }
+            rest.Spawn([&matrix, i, k, tiles]  {
+                for (size_t j = 0; j < tiles; ++j)  {
+                    if (j != k)  {
+                        FloydTile(matrix, i, j, k);
+                    }
+                }
+            });
+        }
+        rest.Wait();
+    }
+}
+
+/**
+ * Кратчайшие расстояния между всеми парами вершин обходами из каждой вершины: обход в ширину для
+ * невзвешенного графа и алгоритм Дейкстры для взвешенного. Источники делятся между потоками.
+ * Подходит для разреженных графов, где V обходов за O(V + E) дешевле, чем O(V^3).
+ * @param graph граф в представлении CSR.
+ * @return матрица расстояний.
+ */
+template<typename Distance, typename Vertex, typename Weight, bool Directed>
+DistanceMatrix<Distance> AllPairsBySource(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    DistanceMatrix<Distance> matrix;
+    size_t n = matrix.verts = graph.Verts();
+    matrix.distances.assign(n * n, DistanceMatrix<Distance>::kInfinity);
+    Parallel::For(n, [&](size_t begin, size_t end, size_t)  {
+        std::vector<Vertex> queue;
+        for (size_t source = begin; source < end; ++source)  {
+            Distance* row = matrix.distances.data() + source * n;
+            if constexpr (CsrGraph<Vertex, Weight, Directed>::kWeighted)  {
+                auto paths = Dijkstra(graph, Vertex(source));
+                for (size_t v = 0; v < n; ++v)  {
+                    if (paths.Reachable(Vertex(v)))  {
+                        row[v] = Distance(paths.distances[v]);
+                    }
+                }
+            }  else  {
+                queue.assign(1, Vertex(source));
+                row[source] = 0;
+                for (size_t head = 0; head < queue.size(); ++head)  {
+                    for (Vertex to : graph.Neighbors(queue[head]))  {
+                        if (row[to] == DistanceMatrix<Distance>::kInfinity)  {
+                            row[to] = row[queue[head]] + 1;
+                            queue.push_back(to);
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return matrix;
+}
+
+/**
+ * Кратчайшие расстояния между всеми парами вершин. Для плотного графа (дуг не меньше V^2 / 16)
+ * используется блочный алгоритм Флойда-Уоршелла, для разреженного - обходы из каждой вершины.
+ * Веса дуг должны быть неотрицательными.
+ * @tparam Distance тип расстояния, для невзвешенного графа хватает 32-битного.
+ * @param graph граф в представлении CSR.
+ * @return матрица расстояний.
+ */
+template<typename Distance = void, typename Vertex, typename Weight, bool Directed>
+auto AllPairsShortestPaths(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    using Result = std::conditional_t<std::is_void_v<Distance>,
+            std::conditional_t<std::is_void_v<Weight>, uint32_t, DistanceType<Weight>>, Distance>;
+    size_t n = graph.Verts();
+    if (graph.Arcs() * 16 < n * n)  {
+        return AllPairsBySource<Result>(graph);
+    }
+    auto matrix = DistanceMatrix<Result>::FromCsr(graph);
+    FloydWarshall(matrix);
+    return matrix;
+}
+
+#endif //GRAPHS_ALLPAIRS_H
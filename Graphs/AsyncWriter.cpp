@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstring>
+#include "AsyncWriter.h"
+
+/**
+ * Конструктор, запускающий поток записи.
+ * @param target поток, в который будут записываться блоки.
+ * @param capacity максимальное количество блоков в очереди.
+ */
+AsyncWriter::AsyncWriter(std::ostream& target, size_t capacity)
+        : mTarget(target), mCapacity(std::max<size_t>(1, capacity)), mBlock(kBlockSize, '\0')  {
+    setp(mBlock.data(), mBlock.data() + mBlock.size());
+    mThread = std::thread(&AsyncWriter::Run, this);
+}
+
+/**
+ * Деструктор дописывает оставшиеся блоки и дожидается завершения потока записи.
+ */
+AsyncWriter::~AsyncWriter()  {
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mNotEmpty.notify_one();
+    mThread.join();
+}
+
+/**
+ * Ожидание записи всех блоков и сброс целевого потока.
+ */
+void AsyncWriter::Flush()  {
+    Push();
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [this]  {
+        return mQueue.empty() && !mBusy;
+    });
+    // Поток записи простаивает, а новые блоки может добавить только вызывающий, поэтому сброс безопасен.
+    mTarget.flush();
+}
+
+/**
+ * Вызывается, когда блок заполнен: блок уходит в очередь, а символ записывается в новый блок.
+ * @param symbol символ, не поместившийся в блок.
+ * @return symbol, либо признак конца файла, если символа нет.
+ */
+AsyncWriter::int_type AsyncWriter::overflow(int_type symbol)  {
+    Push();
+    if (!traits_type::eq_int_type(symbol, traits_type::eof()))  {
+        *pptr() = traits_type::to_char_type(symbol);
+        pbump(1);
+    }
+    return traits_type::not_eof(symbol);
+}
+
+/**
+ * Запись последовательности символов блоками.
+ * @param data символы.
+ * @param size количество символов.
+ * @return количество записанных символов.
+ */
+std::streamsize AsyncWriter::xsputn(const char* data, std::streamsize size)  {
+    std::streamsize left = size;
+    while (left > 0)  {
+        if (pptr() == epptr())  {
+            Push();
+        }
+        std::streamsize chunk = std::min<std::streamsize>(left, epptr() - pptr());
+        std::memcpy(pptr(), data, size_t(chunk));
+        pbump(int(chunk));
+        data += chunk;
+        left -= chunk;
+    }
+    return size;
+}
+
+/**
+ * Вызывается при flush() потока.
+ * @return 0, если целевой поток в порядке, иначе -1.
+ */
+int AsyncWriter::sync()  {
+    Flush();
+    return mTarget ? 0 : -1;
+}
+
+/**
+ * Постановка текущего блока в очередь. Если очередь заполнена, то ожидает, пока поток записи ее разгрузит.
+ */
+void AsyncWriter::Push()  {
+    size_t size = pptr() - pbase();
+    if (size == 0)  {
+        return;
+    }
+    mBlock.resize(size);
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [this]  {
+        return mQueue.size() < mCapacity;
+    });
+    mQueue.push_back(std::move(mBlock));
+    if (mFree.empty())  {
+        mBlock = std::string();
+    }  else  {
+        mBlock = std::move(mFree.back());
+        mFree.pop_back();
+    }
+    lock.unlock();
+    mNotEmpty.notify_one();
+    mBlock.resize(kBlockSize);
+    setp(mBlock.data(), mBlock.data() + mBlock.size());
+}
+
+/**
+ * Функция потока записи: забирает блоки из очереди и пишет их в целевой поток, пока не будет остановлен.
+ */
+void AsyncWriter::Run()  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)  {
+        mNotEmpty.wait(lock, [this]  {
+            return !mQueue.empty() || mStop;
+        });
+        if (mQueue.empty())  {
+            return;
+        }
+        std::string block = std::move(mQueue.front());
+        mQueue.pop_front();
+        mBusy = true;
+        lock.unlock();
+        mTarget.write(block.data(), static_cast<std::streamsize>(block.size()));
+        lock.lock();
+        mBusy = false;
+        if (mFree.size() < mCapacity)  {
+            mFree.push_back(std::move(block));
+        }
+        mNotFull.notify_all();
+    }
+}
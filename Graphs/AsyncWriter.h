@@ -0,0 +1,65 @@
+#ifndef GRAPHS_ASYNCWRITER_H
+#define GRAPHS_ASYNCWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Буфер потока, который отдает заполненные блоки фоновому потоку записи, чтобы вычисления не ждали диска.
+ * Очередь блоков ограничена: если поток записи не успевает, то пишущий ждет освобождения места.
+ * Используется как буфер обычного std::ostream, поэтому все функции, пишущие в поток, работают без изменений.
+ * flush() у такого потока ждет, пока все блоки будут записаны в целевой поток.
+ */
+class AsyncWriter : public std::streambuf  {
+public:
+    // Размер блока.
+    static constexpr size_t kBlockSize = 1 << 16;
+    // Количество блоков в очереди по умолчанию.
+    static constexpr size_t kQueueCapacity = 16;
+    // Запуск потока записи в target.
+    explicit AsyncWriter(std::ostream& target, size_t capacity = kQueueCapacity);
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    // Дописывает все блоки и останавливает поток записи.
+    ~AsyncWriter() override;
+    // Ожидание записи всех блоков и сброс целевого потока.
+    void Flush();
+protected:
+    int_type overflow(int_type symbol) override;
+    std::streamsize xsputn(const char* data, std::streamsize size) override;
+    int sync() override;
+private:
+    // Постановка текущего блока в очередь и начало нового.
+    void Push();
+    // Функция потока записи.
+    void Run();
+    // Целевой поток.
+    std::ostream& mTarget;
+    // Максимальное количество блоков в очереди.
+    size_t mCapacity;
+    // Заполняемый блок.
+    std::string mBlock;
+    // Очередь блоков на запись.
+    std::deque<std::string> mQueue;
+    // Записанные блоки, память которых используется повторно.
+    std::vector<std::string> mFree;
+    // Пишет ли поток записи блок в данный момент.
+    bool mBusy = false;
+    // Признак остановки потока записи.
+    bool mStop = false;
+    std::mutex mMutex;
+    // Оповещение потока записи о новом блоке или остановке.
+    std::condition_variable mNotEmpty;
+    // Оповещение пишущего о свободном месте в очереди или о записи всех блоков.
+    std::condition_variable mNotFull;
+    // Поток записи, запускается последним.
+    std::thread mThread;
+};
+
+#endif //GRAPHS_ASYNCWRITER_H
@@ -0,0 +1,378 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "AsyncWriter.h"
+#include "Batch.h"
+#include "Graph.h"
+#include "Parallel.h"
+#include "QueryExecutor.h"
+#include "Reader.h"
+#include "Server.h"
+
+using namespace std;
+
+// Наибольшее количество потоков, которое можно задать параметром --threads.
+constexpr long long kMaxThreads = 1024;
+
+/**
+ * Вывод справки по параметрам командной строки.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void PrintUsage(ostream& stream)  {
+    stream << "Usage: Graphs [options] [queries]\n"
+              "Options:\n"
+              "  --input <path>      graph file, same format as input.txt (default: input.txt)\n"
+              "  --weights <path>    arc weights: lines <from> <to> <weight>, 0..10^9 (default: 1)\n"
+              "  --format <1/2/3/4>  1 - adjacency matrix, 2 - incidence matrix, 3 - adjacency list, 4 - edge list\n"
+              "  --oriented          graph is oriented (default)\n"
+              "  --undirected        graph is not oriented\n"
+              "  --output <path>     write results to a file instead of the console\n"
+              "  --script <path>     read queries from a file\n"
+              "  --threads <count>   number of threads, 0 - all cores, at most 1024\n"
+              "  --serve <path>      answer queries over a Unix socket instead of running them\n"
+              "  --reorder <mode>    renumber vertices of the served graph: none, degree, bfs, rcm\n"
+              "Queries:\n"
+              "  degrees             vertices degree\n"
+              "  count               total number of edges/arcs\n"
+              "  print <1/2/3/4>     convert and output graph\n"
+              "  rdfs <start_point>  recursive DFS\n"
+              "  dfs <start_point>   non-recursive DFS\n"
+              "  bfs <start_point>   BFS\n"
+              "  paths <start_point> shortest paths to all vertices\n"
+              "  apsp                distances between all pairs of vertices\n"
+              "  closure             reachability matrix\n"
+              "  triangles           triangles and clustering coefficients\n"
+              "  pagerank            PageRank of vertices\n"
+              "  toposort            topological order or a cycle\n"
+              "  msf                 minimum spanning forest\n"
+              "  matching            bipartite check and maximum matching\n"
+              "  kcore               core numbers and degeneracy order\n"
+              "  degree <v>          degree of one vertex\n"
+              "  path <from> <to>    path with the fewest arcs between two vertices\n"
+              "Consecutive degree and path queries run in parallel.\n";
+}
+
+/**
+ * Чтение запросов из потока слов. Запрос - это имя действия и, если нужно, его аргументы.
+ * Слова, начинающиеся с #, и все слова после них до конца строки считаются комментарием.
+ * @param tokens поток со словами запросов.
+ * @param queries вектор, в который добавляются прочитанные запросы.
+ * @return true, если все запросы корректны, иначе false.
+ */
+bool ParseQueries(istream& tokens, vector<Query>& queries)  {
+    // Номер действия и количество его числовых аргументов.
+    static const map<string, pair<int, int>> actions = {
+            {"degrees", {1, 0}}, {"count", {2, 0}}, {"print", {3, 1}},
+            {"rdfs", {4, 1}}, {"dfs", {5, 1}}, {"bfs", {6, 1}},
+            {"paths", {7, 1}}, {"apsp", {8, 0}},
+            {"closure", {9, 0}}, {"triangles", {10, 0}},
+            {"pagerank", {11, 0}}, {"toposort", {12, 0}},
+            {"msf", {13, 0}}, {"matching", {14, 0}}, {"kcore", {15, 0}},
+            {"degree", {16, 1}}, {"path", {17, 2}}
+    };
+    string name;
+    while (tokens >> name)  {
+        string input;
+        if (name[0] == '#')  {
+            getline(tokens, input);
+            continue;
+        }
+        auto action = actions.find(name);
+        if (action == actions.end())  {
+            cerr << "Error: unknown query \"" << name << "\"!\n";
+            return false;
+        }
+        Query query;
+        query.action = action->second.first;
+        int* arguments[] = {&query.argument, &query.target};
+        try  {
+            for (int i = 0; i < action->second.second; ++i)  {
+                if (!(tokens >> input))  {
+                    throw invalid_argument("");
+                }
+                *arguments[i] = stoi(input);
+            }
+        }  catch(exception&)  {
+            cerr << "Error: query \"" << name << "\" needs "
+                 << (action->second.second == 1 ? "a number" : "two numbers") << "!\n";
+            return false;
+        }
+        if (query.action == 3 && (query.argument < 1 || 4 < query.argument))  {
+            cerr << "Error: invalid graph representation in query \"" << name << "\"!\n";
+            return false;
+        }
+        queries.push_back(query);
+    }
+    return true;
+}
+
+/**
+ * Проверка запроса на загруженном графе: стартовая вершина должна существовать, а ориентированность графа -
+ * подходить к действию. В пакетном режиме ошибка не печатается в вывод запросов, а завершает программу.
+ * @param query запрос.
+ * @param verts количество вершин графа.
+ * @param oriented ориентированность графа.
+ * @return true, если запрос можно выполнить, иначе false.
+ */
+bool CheckQuery(const Query& query, size_t verts, bool oriented)  {
+    if (((4 <= query.action && query.action <= 7) || 16 <= query.action) &&
+    (query.argument < 1 || verts < size_t(query.argument)))  {
+        cerr << "Error: invalid start point " << query.argument << "!\n";
+        return false;
+    }
+    if (query.action == 17 && (query.target < 1 || verts < size_t(query.target)))  {
+        cerr << "Error: invalid end point " << query.target << "!\n";
+        return false;
+    }
+    if (query.action == 12 && !oriented)  {
+        cerr << "Error: topological order exists only for oriented graphs!\n";
+        return false;
+    }
+    if ((query.action == 13 || query.action == 14) && oriented)  {
+        cerr << "Error: " << (query.action == 13 ? "spanning forest" : "matching")
+             << " is built only for not oriented graphs!\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Выполнение запроса над загруженным графом. Номера действий совпадают с номерами в меню.
+ * @param query запрос.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void RunQuery(const Query& query, ostream& stream)  {
+    switch (query.action)  {
+        case 1:
+            Graph::VerticesDegree(stream);
+            break;
+        case 2:
+            Graph::CountArcEdges(stream);
+            break;
+        case 3:
+            Graph::Print(query.argument, stream);
+            break;
+        case 4: case 5: case 6:
+            Graph::GraphSearch(query.argument, query.action, stream);
+            break;
+        case 7:
+            Graph::Distances(query.argument, stream);
+            break;
+        case 8:
+            Graph::AllDistances(stream);
+            break;
+        case 9:
+            Graph::PrintClosure(stream);
+            break;
+        case 10:
+            Graph::PrintTriangles(stream);
+            break;
+        case 11:
+            Graph::PrintPageRank(stream);
+            break;
+        case 12:
+            Graph::PrintTopologicalOrder(stream);
+            break;
+        case 13:
+            Graph::PrintSpanningForest(stream);
+            break;
+        case 14:
+            Graph::PrintMatching(stream);
+            break;
+        case 15:
+            Graph::PrintCores(stream);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Проверка, что запрос только читает граф и выполняется исполнителем над снимком графа.
+ * @param query запрос.
+ * @return true для запросов степени вершины и пути между вершинами, иначе false.
+ */
+bool IsSnapshotQuery(const Query& query)  {
+    return query.action == 16 || query.action == 17;
+}
+
+/**
+ * Параллельное выполнение подряд идущих запросов степени вершины и пути между вершинами над снимком графа.
+ * Результаты выводятся в порядке запросов.
+ * @param executor исполнитель запросов над снимком графа.
+ * @param queries запросы, для которых IsSnapshotQuery возвращает true.
+ * @param oriented ориентированность графа.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void RunSnapshotQueries(QueryExecutor& executor, const vector<Query>& queries, bool oriented, ostream& stream)  {
+    vector<GraphQuery> graphQueries;
+    for (auto& query : queries)  {
+        GraphQuery graphQuery;
+        graphQuery.kind = query.action == 16 ? QueryKind::Degree : QueryKind::Path;
+        graphQuery.from = uint32_t(query.argument - 1);
+        graphQuery.to = uint32_t(query.target - 1);
+        graphQueries.push_back(graphQuery);
+    }
+    auto results = executor.RunAll(graphQueries);
+    OutputWriter writer(stream);
+    for (size_t i = 0; i < queries.size(); ++i)  {
+        writer << queries[i].argument << '\t';
+        if (queries[i].action == 16)  {
+            if (oriented)  {
+                writer << "In-degree: " << results[i][0] << '\t' << "Out-degree: " << results[i][1] << '\n';
+            }  else  {
+                writer << "Degree: " << results[i][1] << '\n';
+            }
+            continue;
+        }
+        writer << queries[i].target << '\t';
+        if (results[i].empty())  {
+            writer << "Unreachable\n";
+            continue;
+        }
+        writer << "Distance: " << (results[i].size() - 1) << '\t' << "Path:";
+        for (uint32_t v : results[i])  {
+            writer << ' ' << (v+1);
+        }
+        writer << '\n';
+    }
+}
+
+/**
+ * Запуск программы без меню: граф читается из файла один раз, после чего выполняются все запросы
+ * из командной строки и из файла со сценарием, без вопросов пользователю, либо запускается сервер запросов.
+ * @param argc количество аргументов командной строки.
+ * @param argv аргументы командной строки.
+ * @return код завершения программы.
+ */
+int RunBatch(int argc, char* argv[])  {
+    string inputPath = "input.txt", weightsPath, outputPath, socketPath;
+    int graphMode = 0;
+    bool oriented = true;
+    Reordering reordering = Reordering::None;
+    vector<Query> queries;
+    stringstream tokens;
+    for (int i = 1; i < argc; ++i)  {
+        string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        try  {
+            if (argument == "--help")  {
+                PrintUsage(cout);
+                return 0;
+            }  else if (argument == "--oriented")  {
+                oriented = true;
+            }  else if (argument == "--undirected")  {
+                oriented = false;
+            }  else if (argument == "--input" && hasValue)  {
+                inputPath = argv[++i];
+            }  else if (argument == "--weights" && hasValue)  {
+                weightsPath = argv[++i];
+            }  else if (argument == "--output" && hasValue)  {
+                outputPath = argv[++i];
+            }  else if (argument == "--format" && hasValue)  {
+                graphMode = stoi(argv[++i]);
+            }  else if (argument == "--serve" && hasValue)  {
+                socketPath = argv[++i];
+            }  else if (argument == "--reorder" && hasValue)  {
+                static const map<string, Reordering> modes = {
+                        {"none", Reordering::None}, {"degree", Reordering::Degree},
+                        {"bfs", Reordering::Bfs}, {"rcm", Reordering::ReverseCuthillMcKee}
+                };
+                reordering = modes.at(argv[++i]);
+            }  else if (argument == "--threads" && hasValue)  {
+                // stoul молча переводит -1 в 2^64 - 1, поэтому число читается со знаком.
+                long long threads = stoll(argv[++i]);
+                if (threads < 0 || kMaxThreads < threads)  {
+                    throw out_of_range("");
+                }
+                Parallel::sThreads = size_t(threads);
+            }  else if (argument == "--script" && hasValue)  {
+                ifstream script(argv[++i]);
+                if (!script)  {
+                    cerr << "Error: can't open script " << argv[i] << "!\n";
+                    return 1;
+                }
+                tokens << script.rdbuf() << '\n';
+            }  else if (argument.starts_with("--"))  {
+                throw invalid_argument("");
+            }  else  {
+                tokens << argument << ' ';
+            }
+        }  catch(exception&)  {
+            cerr << "Error: invalid argument " << argument << "!\n";
+            PrintUsage(cerr);
+            return 1;
+        }
+    }
+    if (graphMode < 1 || 4 < graphMode)  {
+        cerr << "Error: --format <1/2/3/4> is required!\n";
+        PrintUsage(cerr);
+        return 1;
+    }
+    if (!ParseQueries(tokens, queries))  {
+        return 1;
+    }
+    if (!std::filesystem::exists(inputPath))  {
+        cerr << "Error: can't open " << inputPath << "!\n";
+        return 1;
+    }
+    ReadGraph(2, graphMode, oriented, inputPath);
+    if (Graph::IsEmpty())  {
+        cerr << "Error: invalid graph in " << inputPath << "!\n";
+        return 1;
+    }
+    if (!weightsPath.empty() && !ReadWeights(weightsPath))  {
+        return 1;
+    }
+    size_t verts = Graph::Snapshot()->Verts();
+    for (auto& query : queries)  {
+        if (!CheckQuery(query, verts, Graph::IsOriented()))  {
+            return 1;
+        }
+    }
+    if (!socketPath.empty())  {
+        Server::Capacities capacities;
+        if (Graph::IsWeighted())  {
+            capacities = make_shared<const CsrGraph<uint32_t, int64_t>>(Graph::ToCsr<uint32_t, int64_t>());
+        }
+        Server server(Graph::Snapshot(), Graph::IsOriented(), reordering, std::move(capacities));
+        return server.Run(socketPath, Parallel::sThreads);
+    }
+    ios::sync_with_stdio(false);
+    ofstream file;
+    unique_ptr<AsyncWriter> fileWriter;
+    ostream stream(cout.rdbuf());
+    if (!outputPath.empty())  {
+        file.open(outputPath);
+        if (!file)  {
+            cerr << "Error: can't open " << outputPath << "!\n";
+            return 1;
+        }
+        fileWriter = make_unique<AsyncWriter>(file);
+        stream.rdbuf(fileWriter.get());
+    }
+    // Подряд идущие запросы к снимку графа выполняются одной параллельной пачкой, остальные - по одному.
+    unique_ptr<QueryExecutor> executor;
+    for (size_t i = 0; i < queries.size();)  {
+        if (!IsSnapshotQuery(queries[i]))  {
+            RunQuery(queries[i++], stream);
+            continue;
+        }
+        size_t end = i;
+        while (end < queries.size() && IsSnapshotQuery(queries[end]))  {
+            ++end;
+        }
+        if (!executor)  {
+            executor = make_unique<QueryExecutor>(Graph::Snapshot(), Parallel::sThreads);
+        }
+        RunSnapshotQueries(*executor, vector<Query>(queries.begin() + i, queries.begin() + end),
+                           Graph::IsOriented(), stream);
+        i = end;
+    }
+    stream.flush();
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef GRAPHS_BATCH_H
+#define GRAPHS_BATCH_H
+#include <istream>
+#include <ostream>
+#include <vector>
+/**
+ * Запрос к графу: действие с теми же номерами, что и в меню, и его аргументы
+ * (представление для вывода, либо стартовая вершина обхода, и конечная вершина пути).
+ * Действия 16 (степень вершины) и 17 (путь между двумя вершинами) есть только в пакетном режиме.
+ */
+struct Query  {
+    int action = 0;
+    int argument = 0;
+    int target = 0;
+};
+// Чтение запросов из потока слов.
+bool ParseQueries(std::istream& tokens, std::vector<Query>& queries);
+// Выполнение запроса над загруженным графом.
+void RunQuery(const Query& query, std::ostream& stream);
+// Запуск программы без меню, с параметрами и запросами из командной строки.
+int RunBatch(int argc, char* argv[]);
+#endif //GRAPHS_BATCH_H
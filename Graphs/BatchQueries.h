@@ -0,0 +1,102 @@
+#ifndef GRAPHS_BATCHQUERIES_H
+#define GRAPHS_BATCHQUERIES_H
+
+#include <span>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "EdgeIndex.h"
+
+// На сколько элементов пачки вперед запрашиваются данные из памяти.
+constexpr size_t kPrefetchDistance = 8;
+
+/**
+ * Подсказка процессору заранее загрузить данные в кэш. Для компиляторов без такой встроенной функции ничего не делает.
+ * @param address адрес данных.
+ */
+template<typename T>
+inline void Prefetch(const T* address)  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+}
+
+/**
+ * Смежные вершины пачки вершин: смежные вершины i-й вершины пачки занимают
+ * отрезок [offsets[i], offsets[i+1]) массива neighbors.
+ */
+template<typename Vertex>
+struct NeighborBatch  {
+    std::vector<size_t> offsets;
+    std::vector<Vertex> neighbors;
+};
+
+/**
+ * Полустепени исхода пачки вершин. Пока обрабатывается i-я вершина, начало списка вершины
+ * на kPrefetchDistance позиций дальше уже загружается из памяти.
+ * @param graph граф в представлении CSR.
+ * @param vertices вершины.
+ * @return полустепени исхода в порядке вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+std::vector<size_t> BatchDegrees(const CsrGraph<Vertex, Weight, Directed>& graph, std::span<const Vertex> vertices)  {
+    std::vector<size_t> degrees(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)  {
+        if (i + kPrefetchDistance < vertices.size())  {
+            Prefetch(&graph.offsets[vertices[i + kPrefetchDistance]]);
+        }
+        degrees[i] = graph.Degree(vertices[i]);
+    }
+    return degrees;
+}
+
+/**
+ * Смежные вершины пачки вершин. Первый проход считает размеры списков, загружая заранее начала списков,
+ * второй копирует списки, загружая заранее сами списки.
+ * @param graph граф в представлении CSR.
+ * @param vertices вершины.
+ * @return смежные вершины в порядке вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+NeighborBatch<Vertex> BatchNeighbors(const CsrGraph<Vertex, Weight, Directed>& graph,
+                                     std::span<const Vertex> vertices)  {
+    NeighborBatch<Vertex> batch;
+    batch.offsets.assign(vertices.size() + 1, 0);
+    std::vector<size_t> degrees = BatchDegrees(graph, vertices);
+    for (size_t i = 0; i < vertices.size(); ++i)  {
+        batch.offsets[i + 1] = batch.offsets[i] + degrees[i];
+    }
+    batch.neighbors.resize(batch.offsets.back());
+    for (size_t i = 0; i < vertices.size(); ++i)  {
+        if (i + kPrefetchDistance < vertices.size())  {
+            Prefetch(graph.targets.data() + graph.offsets[vertices[i + kPrefetchDistance]]);
+        }
+        auto neighbors = graph.Neighbors(vertices[i]);
+        std::copy(neighbors.begin(), neighbors.end(), batch.neighbors.begin() + std::ptrdiff_t(batch.offsets[i]));
+    }
+    return batch;
+}
+
+/**
+ * Проверка наличия дуг для пачки пар вершин по хеш-индексу дуг, в среднем O(1) на пару независимо от степеней.
+ * Пока проверяется i-я пара, ячейка таблицы для пары на kPrefetchDistance позиций дальше уже загружается
+ * из памяти.
+ * @param index индекс дуг графа.
+ * @param arcs пары (начало, конец).
+ * @return для каждой пары 1, если дуга есть, иначе 0.
+ */
+template<typename Vertex>
+std::vector<char> BatchHasArcs(const EdgeIndex<Vertex>& index, std::span<const std::pair<Vertex, Vertex>> arcs)  {
+    std::vector<char> found(arcs.size());
+    for (size_t i = 0; i < arcs.size(); ++i)  {
+        if (i + kPrefetchDistance < arcs.size())  {
+            const auto& [from, to] = arcs[i + kPrefetchDistance];
+            Prefetch(index.ProbeStart(from, to));
+        }
+        found[i] = index.HasEdge(arcs[i].first, arcs[i].second);
+    }
+    return found;
+}
+
+#endif //GRAPHS_BATCHQUERIES_H
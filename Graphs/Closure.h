@@ -0,0 +1,114 @@
+#ifndef GRAPHS_CLOSURE_H
+#define GRAPHS_CLOSURE_H
+
+#include <vector>
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+#include "Condensation.h"
+
+/**
+ * Матрица достижимости (транзитивное замыкание) в виде битовых строк из 64-битных слов.
+ * Строка хранится одна на компоненту сильной связности: все вершины компоненты достигают одного и того же.
+ * Как и SmallGraph::TransitiveClosure, вершина достигает себя, только если лежит на цикле.
+ */
+class ReachabilityMatrix  {
+public:
+    /**
+     * Построение замыкания через конденсацию. Компоненты обрабатываются по уровням: уровень компоненты -
+     * длина самого длинного пути из нее в конденсации. Компоненты одного уровня не зависят друг от друга
+     * и обрабатываются параллельно, строка компоненты - объединение строк и вершин компонент, в которые из нее
+     * есть дуга, целыми словами.
+     * @param graph граф в представлении CSR.
+     * @return матрица достижимости.
+     */
+    template<typename Vertex, typename Weight, bool Directed>
+    static ReachabilityMatrix Build(const CsrGraph<Vertex, Weight, Directed>& graph);
+
+    // Есть ли путь из from в to хотя бы из одной дуги.
+    [[nodiscard]] bool Reaches(size_t from, size_t to) const  {
+        return (Row(from)[to / 64] >> (to % 64)) & 1;
+    }
+    // Строка вершин, достижимых из from.
+    [[nodiscard]] std::span<const uint64_t> Row(size_t from) const  {
+        return {mBits.data() + mComponent[from] * mWords, mWords};
+    }
+    // Количество вершин, достижимых из from.
+    [[nodiscard]] size_t CountReachable(size_t from) const  {
+        size_t count = 0;
+        for (uint64_t word : Row(from))  {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+    // Количество вершин.
+    [[nodiscard]] size_t Verts() const  {
+        return mComponent.size();
+    }
+
+private:
+    // Номер строки (компоненты) каждой вершины.
+    std::vector<size_t> mComponent;
+    // Количество слов в строке.
+    size_t mWords = 0;
+    // Строки компонент подряд.
+    std::vector<uint64_t> mBits;
+};
+
+template<typename Vertex, typename Weight, bool Directed>
+ReachabilityMatrix ReachabilityMatrix::Build(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    auto condensation = Condense(graph);
+    size_t count = condensation.Count();
+    ReachabilityMatrix matrix;
+    matrix.mComponent.assign(condensation.component.begin(), condensation.component.end());
+    matrix.mWords = (graph.Verts() + 63) / 64;
+    matrix.mBits.assign(count * matrix.mWords, 0);
+    // Дуги конденсации идут в компоненты с меньшими номерами, поэтому уровни считаются одним проходом.
+    std::vector<size_t> level(count, 0), offsets(1, 0);
+    for (size_t c = 0; c < count; ++c)  {
+        for (Vertex d : condensation.dag.Neighbors(Vertex(c)))  {
+            level[c] = std::max(level[c], level[d] + 1);
+        }
+        if (offsets.size() < level[c] + 2)  {
+            offsets.resize(level[c] + 2, 0);
+        }
+        ++offsets[level[c] + 1];
+    }
+    for (size_t l = 1; l < offsets.size(); ++l)  {
+        offsets[l] += offsets[l - 1];
+    }
+    std::vector<size_t> position(offsets.begin(), offsets.end() - 1), byLevel(count);
+    for (size_t c = 0; c < count; ++c)  {
+        byLevel[position[level[c]]++] = c;
+    }
+    for (size_t l = 0; l + 1 < offsets.size(); ++l)  {
+        Parallel::For(offsets[l + 1] - offsets[l], [&](size_t begin, size_t end, size_t)  {
+            for (size_t i = offsets[l] + begin; i < offsets[l] + end; ++i)  {
+                size_t c = byLevel[i];
+                uint64_t* row = matrix.mBits.data() + c * matrix.mWords;
+                auto set = [row](Vertex v)  {
+                    row[v / 64] |= uint64_t(1) << (v % 64);
+                };
+                for (Vertex d : condensation.dag.Neighbors(Vertex(c)))  {
+                    const uint64_t* next = matrix.mBits.data() + size_t(d) * matrix.mWords;
+                    for (size_t w = 0; w < matrix.mWords; ++w)  {
+                        row[w] |= next[w];
+                    }
+                    // Вершины компоненты на цикле уже есть в ее строке.
+                    if (!condensation.cyclic[d])  {
+                        std::for_each(condensation.Members(d).begin(), condensation.Members(d).end(), set);
+                    }
+                }
+                if (condensation.cyclic[c])  {
+                    std::for_each(condensation.Members(Vertex(c)).begin(), condensation.Members(Vertex(c)).end(), set);
+                }
+            }
+        });
+    }
+    return matrix;
+}
+
+#endif //GRAPHS_CLOSURE_H
@@ -0,0 +1,128 @@
+#ifndef GRAPHS_CONDENSATION_H
+#define GRAPHS_CONDENSATION_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "CsrGraph.h"
+
+/**
+ * Конденсация графа: компоненты сильной связности и орграф между ними.
+ * Компоненты нумеруются в обратном топологическом порядке (как их находит алгоритм Тарьяна),
+ * поэтому каждая дуга конденсации идет из компоненты с большим номером в компоненту с меньшим.
+ * Для неорграфа компоненты сильной связности совпадают с компонентами связности.
+ */
+template<typename Vertex>
+struct Condensation  {
+    // Номер компоненты каждой вершины.
+    std::vector<Vertex> component;
+    // Вершины компоненты c занимают отрезок [offsets[c], offsets[c+1]) массива members.
+    std::vector<size_t> offsets;
+    std::vector<Vertex> members;
+    // Есть ли в компоненте цикл: больше одной вершины или петля.
+    std::vector<char> cyclic;
+    // Орграф между компонентами без кратных дуг и петель.
+    CsrGraph<Vertex> dag;
+
+    // Количество компонент.
+    [[nodiscard]] size_t Count() const  {
+        return cyclic.size();
+    }
+    // Вершины компоненты.
+    [[nodiscard]] std::span<const Vertex> Members(Vertex c) const  {
+        return {members.data() + offsets[c], members.data() + offsets[c + 1]};
+    }
+};
+
+/**
+ * Построение конденсации нерекурсивным алгоритмом Тарьяна за O(V + E).
+ * @param graph граф в представлении CSR.
+ * @return компоненты сильной связности и орграф между ними.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Condensation<Vertex> Condense(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    constexpr Vertex none = std::numeric_limits<Vertex>::max();
+    size_t verts = graph.Verts();
+    Condensation<Vertex> result;
+    result.component.assign(verts, none);
+    std::vector<Vertex> index(verts, none), low(verts), stack;
+    std::vector<char> onStack(verts, 0);
+    // Стек вызовов: вершина и индекс следующей дуги.
+    std::vector<std::pair<Vertex, size_t>> calls;
+    Vertex counter = 0, count = 0;
+    auto open = [&](Vertex v)  {
+        index[v] = low[v] = counter++;
+        stack.push_back(v);
+        onStack[v] = 1;
+        calls.emplace_back(v, graph.offsets[v]);
+    };
+    for (size_t root = 0; root < verts; ++root)  {
+        if (index[root] != none)  {
+            continue;
+        }
+        open(Vertex(root));
+        while (!calls.empty())  {
+            auto [v, arc] = calls.back();
+            if (arc < graph.offsets[v + 1])  {
+                ++calls.back().second;
+                Vertex to = graph.targets[arc];
+                if (index[to] == none)  {
+                    open(to);
+                }  else if (onStack[to])  {
+                    low[v] = std::min(low[v], index[to]);
+                }
+                continue;
+            }
+            if (low[v] == index[v])  {
+                Vertex w;
+                do  {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    result.component[w] = count;
+                } while (w != v);
+                ++count;
+            }
+            calls.pop_back();
+            if (!calls.empty())  {
+                Vertex parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+        }
+    }
+    // Вершины по компонентам подсчетом.
+    result.offsets.assign(size_t(count) + 1, 0);
+    for (Vertex c : result.component)  {
+        ++result.offsets[size_t(c) + 1];
+    }
+    for (size_t c = 0; c < count; ++c)  {
+        result.offsets[c + 1] += result.offsets[c];
+    }
+    std::vector<size_t> position(result.offsets.begin(), result.offsets.end() - 1);
+    result.members.resize(verts);
+    for (size_t v = 0; v < verts; ++v)  {
+        result.members[position[result.component[v]]++] = Vertex(v);
+    }
+    // Дуги между компонентами, повторы отсекаются отметкой последней компоненты, из которой шла дуга.
+    result.cyclic.assign(count, 0);
+    std::vector<Vertex> seen(count, none);
+    std::vector<Edge<Vertex, void>> arcs;
+    for (Vertex c = 0; c < count; ++c)  {
+        result.cyclic[c] = result.offsets[c + 1] - result.offsets[c] > 1;
+        for (Vertex v : result.Members(c))  {
+            for (Vertex to : graph.Neighbors(v))  {
+                Vertex d = result.component[to];
+                if (d == c)  {
+                    result.cyclic[c] = 1;
+                }  else if (seen[d] != c)  {
+                    seen[d] = c;
+                    arcs.push_back({c, d});
+                }
+            }
+        }
+    }
+    result.dag = CsrGraph<Vertex>::FromEdges(count, arcs);
+    return result;
+}
+
+#endif //GRAPHS_CONDENSATION_H
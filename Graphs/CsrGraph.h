@@ -0,0 +1,187 @@
+#ifndef GRAPHS_CSRGRAPH_H
+#define GRAPHS_CSRGRAPH_H
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Дуга графа с весом. Для невзвешенного графа (Weight = void) вес не хранится.
+ */
+template<typename Vertex, typename Weight>
+struct Edge  {
+    Vertex from;
+    Vertex to;
+    Weight weight;
+};
+
+template<typename Vertex>
+struct Edge<Vertex, void>  {
+    Vertex from;
+    Vertex to;
+};
+
+/**
+ * Компактное представление списка смежности (CSR): смежные вершины всех вершин лежат в одном массиве,
+ * а смежные вершины вершины v занимают отрезок [offsets[v], offsets[v+1]).
+ * Вершины нумеруются с 0.
+ * Для орграфа дополнительно хранятся входящие дуги в таком же виде. Неорграф хранит каждое ребро в обе стороны
+ * в основном массиве, поэтому входящие дуги у него совпадают с исходящими и отдельно не хранятся.
+ * @tparam Vertex тип номера вершины, по умолчанию 32-битный.
+ * @tparam Weight тип веса дуги, void - невзвешенный граф, для которого веса не хранятся вовсе.
+ * @tparam Directed ориентированность графа.
+ */
+template<typename Vertex = uint32_t, typename Weight = void, bool Directed = true>
+struct CsrGraph  {
+    static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+    using VertexType = Vertex;
+    using WeightType = Weight;
+    using EdgeType = Edge<Vertex, Weight>;
+    // Взвешен ли граф. Алгоритмы проверяют это через if constexpr, поэтому невзвешенный граф не платит за веса.
+    static constexpr bool kWeighted = !std::is_void_v<Weight>;
+    // Ориентированность графа.
+    static constexpr bool kDirected = Directed;
+    // Заглушка вместо массива, который не нужен в данном виде графа. Типы заглушек различны,
+    // чтобы компилятор мог не выделять под них память.
+    template<int Tag>
+    struct Unused  {};
+
+    // Начало списка смежных вершин каждой вершины, размер - количество вершин + 1.
+    std::vector<size_t> offsets;
+    // Смежные вершины.
+    std::vector<Vertex> targets;
+    // Веса дуг в том же порядке, что и targets.
+    [[no_unique_address]] std::conditional_t<kWeighted, std::vector<Weight>, Unused<0>> weights;
+    // Начало списка входящих дуг каждой вершины (только для орграфа).
+    [[no_unique_address]] std::conditional_t<Directed, std::vector<size_t>, Unused<1>> inOffsets;
+    // Начала входящих дуг (только для орграфа).
+    [[no_unique_address]] std::conditional_t<Directed, std::vector<Vertex>, Unused<2>> inSources;
+
+    // Количество вершин.
+    [[nodiscard]] size_t Verts() const  {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+    // Количество дуг, в неорграфе каждое ребро учитывается дважды.
+    [[nodiscard]] size_t Arcs() const  {
+        return targets.size();
+    }
+    // Количество ребер неорграфа.
+    [[nodiscard]] size_t Edges() const requires (!Directed)  {
+        return targets.size() / 2;
+    }
+    // Полустепень исхода вершины, либо степень вершины неорграфа.
+    [[nodiscard]] size_t Degree(Vertex v) const  {
+        return offsets[v + 1] - offsets[v];
+    }
+    // Полустепень захода вершины.
+    [[nodiscard]] size_t InDegree(Vertex v) const  {
+        if constexpr (Directed)  {
+            return inOffsets[v + 1] - inOffsets[v];
+        }  else  {
+            return Degree(v);
+        }
+    }
+    // Смежные вершины вершины v.
+    [[nodiscard]] std::span<const Vertex> Neighbors(Vertex v) const  {
+        return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+    }
+    // Вершины, из которых есть дуга в v.
+    [[nodiscard]] std::span<const Vertex> InNeighbors(Vertex v) const  {
+        if constexpr (Directed)  {
+            return {inSources.data() + inOffsets[v], inSources.data() + inOffsets[v + 1]};
+        }  else  {
+            return Neighbors(v);
+        }
+    }
+    // Вес дуги с индексом arc в targets, для невзвешенного графа всегда 1.
+    [[nodiscard]] auto WeightOf(size_t arc) const  {
+        if constexpr (kWeighted)  {
+            return weights[arc];
+        }  else  {
+            return Vertex(1);
+        }
+    }
+    // Построение списков входящих дуг по исходящим.
+    void BuildIncoming();
+    // Построение графа из списка дуг.
+    static CsrGraph FromEdges(size_t verts, const std::vector<EdgeType>& edges);
+};
+
+/**
+ * Построение списков входящих дуг по исходящим подсчетом полустепеней захода и префиксными суммами.
+ * Входящие дуги каждой вершины упорядочены по возрастанию начала. Для неорграфа ничего не делает.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+void CsrGraph<Vertex, Weight, Directed>::BuildIncoming()  {
+    if constexpr (Directed)  {
+        size_t verts = Verts();
+        inOffsets.assign(verts + 1, 0);
+        for (Vertex to : targets)  {
+            ++inOffsets[size_t(to) + 1];
+        }
+        for (size_t i = 0; i < verts; ++i)  {
+            inOffsets[i + 1] += inOffsets[i];
+        }
+        std::vector<size_t> position(inOffsets.begin(), inOffsets.end() - 1);
+        inSources.resize(targets.size());
+        for (size_t v = 0; v < verts; ++v)  {
+            for (size_t arc = offsets[v]; arc < offsets[v + 1]; ++arc)  {
+                inSources[position[targets[arc]]++] = Vertex(v);
+            }
+        }
+    }
+}
+
+/**
+ * Построение графа из списка дуг подсчетом степеней и префиксными суммами.
+ * Порядок смежных вершин каждой вершины совпадает с порядком дуг в списке.
+ * Для неорграфа каждое ребро задается один раз и сохраняется в обе стороны.
+ * @param verts количество вершин.
+ * @param edges список дуг с вершинами, пронумерованными с 0.
+ * @return граф в представлении CSR.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+CsrGraph<Vertex, Weight, Directed> CsrGraph<Vertex, Weight, Directed>::FromEdges(size_t verts,
+                                                                                  const std::vector<EdgeType>& edges)  {
+    CsrGraph graph;
+    graph.offsets.assign(verts + 1, 0);
+    for (auto& edge : edges)  {
+        ++graph.offsets[size_t(edge.from) + 1];
+        if constexpr (!Directed)  {
+            ++graph.offsets[size_t(edge.to) + 1];
+        }
+    }
+    for (size_t i = 0; i < verts; ++i)  {
+        graph.offsets[i + 1] += graph.offsets[i];
+    }
+    std::vector<size_t> position(graph.offsets.begin(), graph.offsets.end() - 1);
+    graph.targets.resize(graph.offsets[verts]);
+    if constexpr (kWeighted)  {
+        graph.weights.resize(graph.offsets[verts]);
+    }
+    for (auto& edge : edges)  {
+        size_t arc = position[edge.from]++;
+        graph.targets[arc] = edge.to;
+        if constexpr (kWeighted)  {
+            graph.weights[arc] = edge.weight;
+        }
+        if constexpr (!Directed)  {
+            arc = position[edge.to]++;
+            graph.targets[arc] = edge.from;
+            if constexpr (kWeighted)  {
+                graph.weights[arc] = edge.weight;
+            }
+        }
+    }
+    graph.BuildIncoming();
+    return graph;
+}
+
+// Неориентированный граф.
+template<typename Vertex = uint32_t, typename Weight = void>
+using UndirectedCsrGraph = CsrGraph<Vertex, Weight, false>;
+
+#endif //GRAPHS_CSRGRAPH_H
@@ -0,0 +1,159 @@
+#ifndef GRAPHS_EDGEINDEX_H
+#define GRAPHS_EDGEINDEX_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "CsrGraph.h"
+
+/**
+ * Индекс наличия дуг для разреженного графа: хеш-таблица пар (начало, конец) с открытой адресацией
+ * и линейным пробированием. Памяти нужно O(E) вместо O(V^2) у матрицы смежности, проверка - в среднем O(1).
+ * По желанию перед таблицей проверяется фильтр Блума (по байту на дугу): если большинство проверяемых дуг
+ * отсутствует, ответ чаще всего получается без обращения к таблице.
+ * @tparam Vertex тип номера вершины, не шире 32 бит.
+ */
+template<typename Vertex = uint32_t>
+class EdgeIndex  {
+    static_assert(std::is_unsigned_v<Vertex> && sizeof(Vertex) <= 4, "Vertex must fit into 32 bits");
+public:
+    /**
+     * Пустой индекс.
+     * @param capacity ожидаемое количество дуг.
+     * @param bloom нужен ли фильтр Блума.
+     */
+    explicit EdgeIndex(size_t capacity = 0, bool bloom = false) : mBloomEnabled(bloom)  {
+        Rehash(capacity);
+    }
+
+    /**
+     * Индекс всех дуг графа. Ребро неорграфа попадает в индекс в обе стороны.
+     * @param graph граф в представлении CSR.
+     * @param bloom нужен ли фильтр Блума.
+     */
+    template<typename Weight, bool Directed>
+    static EdgeIndex FromCsr(const CsrGraph<Vertex, Weight, Directed>& graph, bool bloom = false)  {
+        EdgeIndex index(graph.Arcs(), bloom);
+        for (size_t v = 0; v < graph.Verts(); ++v)  {
+            for (Vertex u : graph.Neighbors(Vertex(v)))  {
+                index.Insert(Vertex(v), u);
+            }
+        }
+        return index;
+    }
+
+    /**
+     * Добавление дуги.
+     * @param from начало дуги.
+     * @param to конец дуги.
+     * @return true, если дуги еще не было в индексе.
+     */
+    bool Insert(Vertex from, Vertex to)  {
+        if (2 * (mSize + 1) > mKeys.size())  {
+            Rehash(2 * (mSize + 1));
+        }
+        uint64_t key = Key(from, to), hash = Hash(key);
+        size_t slot = Find(key, hash);
+        if (mKeys[slot] == key)  {
+            return false;
+        }
+        mKeys[slot] = key;
+        ++mSize;
+        if (mBloomEnabled)  {
+            mBloom[(hash >> 32) & mBloomMask] |= BloomBits(hash);
+        }
+        return true;
+    }
+
+    /**
+     * Проверка наличия дуги.
+     * @param from начало дуги.
+     * @param to конец дуги.
+     * @return true, если дуга есть в индексе.
+     */
+    [[nodiscard]] bool HasEdge(Vertex from, Vertex to) const  {
+        uint64_t key = Key(from, to), hash = Hash(key);
+        if (mBloomEnabled)  {
+            uint8_t bits = BloomBits(hash);
+            if ((mBloom[(hash >> 32) & mBloomMask] & bits) != bits)  {
+                return false;
+            }
+        }
+        return mKeys[Find(key, hash)] == key;
+    }
+
+    /**
+     * Ячейка таблицы, с которой начнется поиск дуги. Ее можно заранее загрузить в кэш перед HasEdge.
+     * @param from начало дуги.
+     * @param to конец дуги.
+     * @return адрес ячейки.
+     */
+    [[nodiscard]] const uint64_t* ProbeStart(Vertex from, Vertex to) const  {
+        return mKeys.data() + (Hash(Key(from, to)) & (mKeys.size() - 1));
+    }
+
+    // Количество дуг в индексе.
+    [[nodiscard]] size_t Size() const  {
+        return mSize;
+    }
+
+private:
+    // Пустая ячейка таблицы. Такой пары не бывает, потому что номера вершин меньше 2^32 - 1.
+    static constexpr uint64_t kEmpty = ~uint64_t(0);
+
+    static uint64_t Key(Vertex from, Vertex to)  {
+        return (uint64_t(from) << 32) | uint64_t(to);
+    }
+    // Перемешивание битов ключа (splitmix64), чтобы соседние пары не попадали в соседние ячейки.
+    static uint64_t Hash(uint64_t key)  {
+        key += 0x9e3779b97f4a7c15ULL;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+    }
+    // Два бита байта фильтра Блума, выбранные по хешу.
+    static uint8_t BloomBits(uint64_t hash)  {
+        return uint8_t((1u << ((hash >> 56) & 7)) | (1u << ((hash >> 59) & 7)));
+    }
+    // Ячейка с данным ключом либо первая пустая ячейка на пути пробирования.
+    [[nodiscard]] size_t Find(uint64_t key, uint64_t hash) const  {
+        size_t mask = mKeys.size() - 1;
+        size_t slot = hash & mask;
+        while (mKeys[slot] != key && mKeys[slot] != kEmpty)  {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+    // Перестройка таблицы под заданное количество дуг, размер таблицы - степень двойки, заполнение не больше половины.
+    void Rehash(size_t capacity)  {
+        size_t size = 16;
+        while (size < 2 * capacity)  {
+            size *= 2;
+        }
+        std::vector<uint64_t> keys(size, kEmpty);
+        std::swap(keys, mKeys);
+        mSize = 0;
+        if (mBloomEnabled)  {
+            mBloom.assign(size / 2, 0);
+            mBloomMask = mBloom.size() - 1;
+        }
+        for (uint64_t key : keys)  {
+            if (key != kEmpty)  {
+                Insert(Vertex(key >> 32), Vertex(key));
+            }
+        }
+    }
+
+    // Ячейки таблицы.
+    std::vector<uint64_t> mKeys;
+    // Фильтр Блума, по одному байту на дугу.
+    std::vector<uint8_t> mBloom;
+    // Маска номера байта фильтра.
+    size_t mBloomMask = 0;
+    // Количество дуг в индексе.
+    size_t mSize = 0;
+    // Используется ли фильтр Блума.
+    bool mBloomEnabled;
+};
+
+#endif //GRAPHS_EDGEINDEX_H
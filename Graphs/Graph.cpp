@@ -1,107 +1,161 @@
 #include <utility>
+#include <tuple>
+#include <algorithm>
 #include "Graph.h"
+#include "ShortestPaths.h"
+#include "AllPairs.h"
+#include "Closure.h"
+#include "SmallGraph.h"
+#include "Triangles.h"
+#include "PageRank.h"
+#include "TopologicalSort.h"
+#include "SpanningForest.h"
+#include "Matching.h"
+#include "KCore.h"
 
 /**
  * Универсальный конструктор для графа в любом представлении.
  * @param matrix заданный граф.
  * @param mode способ представления графа (матрица смежности и т.д.).
+ * @param oriented ориентированность графа.
  */
-Graph::Graph(std::vector<std::vector<int>> matrix, int mode) {
+Graph::Graph(std::vector<std::vector<int>> matrix, int mode, bool oriented) {
     sGraph = std::move(matrix);
     sCurrentMode = mode;
+    sOriented = oriented;
 }
 
 /**
  * Конвертер из матрицы смежности в матрицу инцидентности.
+ * Сначала для каждой строки подсчитывается количество ребер/дуг, которые она порождает, затем префиксные суммы
+ * дают номер первого столбца строки, после чего строки заполняют свои столбцы параллельно.
  */
 void Graph::FromAdjacencyToIncidenceMatrix()  {
-    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(sGraph.size());
-    for (int i = 0; i < sGraph.size(); ++i)  {
-        for (int j = 0; j < sGraph.size(); ++j)  {
-            // Случай, если у нас дуга.
-            if (sGraph[i][j] == 1 && sGraph[j][i] == 0)  {
-                for (int row = 0; row < matrix.size(); ++row)  {
-                    if (row == i)  {
-                        matrix[row].emplace_back(1);
-                    }  else if (row == j)  {
-                        matrix[row].emplace_back(-1);
-                    }  else  {
-                        matrix[row].emplace_back(0);
-                    }
+    size_t verts = sGraph.size();
+    std::vector<size_t> offsets(verts + 1, 0);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            for (size_t j = 0; j < verts; ++j)  {
+                // Дуга, либо ребро, которое учитывается только один раз.
+                if (sGraph[i][j] == 1 && (sGraph[j][i] == 0 || i < j))  {
+                    ++offsets[i + 1];
                 }
+            }
+        }
+    });
+    for (size_t i = 0; i < verts; ++i)  {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>
+            (verts, std::vector<int>(offsets[verts], 0));
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            size_t column = offsets[i];
+            for (size_t j = 0; j < verts; ++j)  {
+                // Случай, если у нас дуга.
+                if (sGraph[i][j] == 1 && sGraph[j][i] == 0)  {
+                    matrix[i][column] = 1;
+                    matrix[j][column++] = -1;
                 // Случай, если у нас ребро.
-            }  else  if (sGraph[i][j] == 1 && sGraph[j][i] == 1 && i < j)  {
-                for (int row = 0; row < matrix.size(); ++row)  {
-                    if (row == i || row == j)  {
-                        matrix[row].emplace_back(1);
-                    }  else  {
-                        matrix[row].emplace_back(0);
-                    }
+                }  else if (sGraph[i][j] == 1 && sGraph[j][i] == 1 && i < j)  {
+                    matrix[i][column] = 1;
+                    matrix[j][column++] = 1;
                 }
             }
         }
-    }
+    });
     sGraph = std::move(matrix);
 }
 
 /**
  * Конвертер из матрицы смежности в список смежности.
+ * Строки независимы, поэтому разбиваются между потоками.
  */
 void Graph::FromAdjacencyMatrixToList()  {
     std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(sGraph.size());
-    for (int i = 0; i < sGraph.size(); ++i)  {
-        for (int j = 0; j < sGraph.size(); ++j)  {
-            if (sGraph[i][j] == 1)  {
-                matrix[i].emplace_back(j+1);
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            for (size_t j = 0; j < sGraph.size(); ++j)  {
+                if (sGraph[i][j] == 1)  {
+                    matrix[i].emplace_back(int(j)+1);
+                }
             }
         }
-    }
+    });
     sGraph = std::move(matrix);
 }
 
 /**
  * Конвертер из матрицы смежности в список ребер.
+ * Префиксные суммы степеней строк дают позицию первой дуги каждой строки в списке ребер.
  */
 void Graph::FromAdjacencyMatrixToEdgeList()  {
-    std::vector<std::vector<int>> matrix;
     sVerts = sGraph.size();
-    for (int i = 0; i < sGraph.size(); ++i)  {
-        for (int j = 0; j < sGraph.size(); ++j)  {
-            if (sGraph[i][j] == 1)  {
-                matrix.emplace_back(std::vector<int>{(i+1), (j+1)});
+    std::vector<size_t> offsets(sVerts + 1, 0);
+    Parallel::For(sVerts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            for (size_t j = 0; j < sVerts; ++j)  {
+                offsets[i + 1] += sGraph[i][j];
             }
         }
+    });
+    for (size_t i = 0; i < sVerts; ++i)  {
+        offsets[i + 1] += offsets[i];
     }
+    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(offsets[sVerts]);
+    Parallel::For(sVerts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            size_t position = offsets[i];
+            for (size_t j = 0; j < sVerts; ++j)  {
+                if (sGraph[i][j] == 1)  {
+                    matrix[position++] = std::vector<int>{int(i)+1, int(j)+1};
+                }
+            }
+        }
+    });
     sGraph = std::move(matrix);
 }
 
 /**
  * Конвертер из матрицы инцидентности в матрицу смежности.
+ * Столбцы разбираются параллельно, а найденные дуги записываются в матрицу смежности последовательно.
  */
 void Graph::FromIncidenceToAdjacencyMatrix()  {
     std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>
             (sGraph.size(), std::vector<int>(sGraph.size(), 0));
-    for (int i = 0; i < sGraph[0].size(); ++i)  {
-        // Пары чисел, где первое число в каждой паре - число из матрицы,
-        // а второе - индекс строки матрицы, в которой он находится. В каждом столбце есть ровно 2 ненулевых числа,
-        // поэтому нужны две пары.
-        std::pair<int, int> x, y;
-        for (int j = 0; j < sGraph.size(); ++j)  {
-            if (abs(sGraph[j][i]) == 1)  {
-                if (x.first == 0)  {
-                    x = {sGraph[j][i], j};
-                }  else  {
-                    y = {sGraph[j][i], j} ;
+    size_t edges = sGraph.empty() ? 0 : sGraph[0].size();
+    // Для каждого столбца начало и конец дуги, а также является ли она ребром.
+    std::vector<std::pair<int, int>> arcs(edges);
+    std::vector<char> undirected(edges, 0);
+    Parallel::For(edges, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            // Пары чисел, где первое число в каждой паре - число из матрицы,
+            // а второе - индекс строки матрицы, в которой он находится. В каждом столбце есть ровно 2 ненулевых числа,
+            // поэтому нужны две пары.
+            std::pair<int, int> x, y;
+            for (size_t j = 0; j < sGraph.size(); ++j)  {
+                if (abs(sGraph[j][i]) == 1)  {
+                    if (x.first == 0)  {
+                        x = {sGraph[j][i], int(j)};
+                    }  else  {
+                        y = {sGraph[j][i], int(j)};
+                    }
                 }
             }
+            if (x.first == 1 && y.first == 1)  {
+                arcs[i] = {x.second, y.second};
+                undirected[i] = 1;
+            }  else  if (x.first == 1 && y.first == -1)  {
+                arcs[i] = {x.second, y.second};
+            }  else  {
+                arcs[i] = {y.second, x.second};
+            }
         }
-        if (x.first == 1 && y.first == 1)  {
-            matrix[x.second][y.second] = 1;
-            matrix[y.second][x.second] = 1;
-        }  else  if (x.first == 1 && y.first == -1)  {
-            matrix[x.second][y.second] = 1;
-        }  else  {
-            matrix[y.second][x.second] = 1;
+    });
+    for (size_t i = 0; i < edges; ++i)  {
+        matrix[arcs[i].first][arcs[i].second] = 1;
+        if (undirected[i])  {
+            matrix[arcs[i].second][arcs[i].first] = 1;
         }
     }
     sGraph = std::move(matrix);
@@ -109,27 +163,92 @@ void Graph::FromIncidenceToAdjacencyMatrix()  {
 
 /**
  * Конвертер из списка смежности в матрицу смежности.
+ * Строки независимы, поэтому разбиваются между потоками.
  */
 void Graph::FromAdjacencyListToMatrix()  {
-    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>
-            (sGraph.size(), std::vector<int>(sGraph.size(), 0));
-    for (int i = 0; i < sGraph.size(); ++i)  {
-        for (int j = 0; j < sGraph[i].size(); ++j)  {
-            matrix[i][sGraph[i][j]-1] = 1;
+    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(sGraph.size());
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            matrix[i].assign(sGraph.size(), 0);
+            for (int j : sGraph[i])  {
+                matrix[i][j-1] = 1;
+            }
         }
+    });
+    sGraph = std::move(matrix);
+}
+
+/**
+ * Конвертер из списка смежности в список ребер.
+ * Префиксные суммы длин списков дают позицию первой дуги каждой вершины в списке ребер.
+ */
+void Graph::FromAdjacencyListToEdgeList()  {
+    sVerts = sGraph.size();
+    std::vector<size_t> offsets(sVerts + 1, 0);
+    for (size_t i = 0; i < sVerts; ++i)  {
+        offsets[i + 1] = offsets[i] + sGraph[i].size();
     }
+    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(offsets[sVerts]);
+    Parallel::For(sVerts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            for (size_t j = 0; j < sGraph[i].size(); ++j)  {
+                matrix[offsets[i] + j] = std::vector<int>{int(i)+1, sGraph[i][j]};
+            }
+        }
+    });
     sGraph = std::move(matrix);
 }
 
 /**
  * Конвертер из списка ребер в матрицу смежности.
+ * Дубликаты удалены при чтении, поэтому каждая дуга пишет в свою ячейку и дуги можно разбить между потоками.
  */
 void Graph::FromEdgeListToAdjacencyMatrix()  {
     std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>
             (sVerts, std::vector<int>(sVerts, 0));
-    for (auto& row : sGraph) {
-        matrix[row[0]-1][row[1]-1] = 1;
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            matrix[sGraph[i][0]-1][sGraph[i][1]-1] = 1;
+        }
+    });
+    sGraph = std::move(matrix);
+}
+
+/**
+ * Конвертер из списка ребер в список смежности.
+ * Каждый поток считает, сколько дуг из его блока выходит из каждой вершины, по этим счетчикам вычисляются
+ * позиции, после чего потоки раскладывают свои дуги по спискам. Списки сортируются, поэтому результат совпадает
+ * с конвертацией через матрицу смежности.
+ */
+void Graph::FromEdgeListToAdjacencyList()  {
+    size_t threads = Parallel::ThreadCount(sGraph.size());
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(sVerts, 0));
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t block)  {
+        for (size_t i = begin; i < end; ++i)  {
+            ++counts[block][sGraph[i][0]-1];
+        }
+    });
+    std::vector<std::vector<int>> matrix = std::vector<std::vector<int>>(sVerts);
+    for (size_t v = 0; v < sVerts; ++v)  {
+        size_t size = 0;
+        for (size_t block = 0; block < threads; ++block)  {
+            size_t count = counts[block][v];
+            counts[block][v] = size;
+            size += count;
+        }
+        matrix[v].resize(size);
     }
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t block)  {
+        for (size_t i = begin; i < end; ++i)  {
+            int from = sGraph[i][0]-1;
+            matrix[from][counts[block][from]++] = sGraph[i][1];
+        }
+    });
+    Parallel::For(sVerts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            std::sort(matrix[i].begin(), matrix[i].end());
+        }
+    });
     sGraph = std::move(matrix);
 }
 
@@ -162,16 +281,14 @@ void Graph::Convert(int outputMode)  {
         FromAdjacencyListToMatrix();
         FromAdjacencyToIncidenceMatrix();
     }  else if (sCurrentMode == 3 && outputMode == 4)  {
-        FromAdjacencyListToMatrix();
-        FromAdjacencyMatrixToEdgeList();
+        FromAdjacencyListToEdgeList();
     }  else if (sCurrentMode == 4 && outputMode == 1)  {
         FromEdgeListToAdjacencyMatrix();
     }  else if (sCurrentMode == 4 && outputMode == 2)  {
         FromEdgeListToAdjacencyMatrix();
         FromAdjacencyToIncidenceMatrix();
     }  else if (sCurrentMode == 4 && outputMode == 3)  {
-        FromEdgeListToAdjacencyMatrix();
-        FromAdjacencyMatrixToList();
+        FromEdgeListToAdjacencyList();
     }
     sCurrentMode = outputMode;
 }
@@ -184,52 +301,98 @@ bool Graph::IsEmpty() {
     return sGraph.empty() && sCurrentMode == 0;
 }
 
+/**
+ * Ориентированность заданного графа.
+ * @return true, если граф ориентированный, иначе false.
+ */
+bool Graph::IsOriented()  {
+    return sOriented;
+}
+
+/**
+ * Задание весов дуг. У неорграфа вес должен быть задан обоим направлениям ребра.
+ * @param weights веса дуг (начало, конец) с нумерацией вершин с 1.
+ */
+void Graph::SetWeights(std::map<std::pair<int, int>, int64_t> weights)  {
+    sWeights = std::move(weights);
+}
+
+/**
+ * Проверка, заданы ли веса дуг.
+ * @return true, если задан вес хотя бы одной дуги, иначе false.
+ */
+bool Graph::IsWeighted()  {
+    return !sWeights.empty();
+}
+
+/**
+ * Неизменяемый снимок графа. В отличие от методов Graph, которые конвертируют заданный граф при каждом вызове,
+ * снимок никто не изменяет, поэтому его можно читать из многих потоков сразу.
+ * @return снимок графа в представлении CSR.
+ */
+std::shared_ptr<const CsrGraph<>> Graph::Snapshot()  {
+    return std::make_shared<const CsrGraph<>>(ToCsr());
+}
+
 /**
  * Функция производит подсчет степеней/полустепеней вершин и выводит их в поток.
- * @param oriented ориентированность графа.
+ * Ориентированность проверяется один раз, дальше работает ядро, скомпилированное под нужный вид графа.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::VerticesDegree(bool oriented, std::ostream &stream) {
+void Graph::VerticesDegree(std::ostream &stream) {
     // Произвожу подсчет в матрице смежности, поэтому конвертирую в нее, подсчитываю и после конвертирую обратно.
     int mode = sCurrentMode;
     Convert(1);
-    if (oriented)  {
-        for (int i = 0; i < sGraph.size(); ++i)  {
-            int inDegree = 0, outDegree = 0;
-            stream << (i+1) << '\t';
-            for (int j = 0; j < sGraph.size(); ++j)  {
-                outDegree += sGraph[i][j];
-            }
-            for (auto& col : sGraph)  {
-                inDegree += col[i];
-            }
-            stream << "In-degree: " << inDegree << '\t' << "Out-degree: " << outDegree << '\n';
-        }
+    OutputWriter writer(stream);
+    if (sOriented)  {
+        PrintDegrees<true>(writer);
     }  else  {
-        for (int i = 0; i < sGraph.size(); ++i)  {
-            int degree = 0;
-            stream << (i+1) << '\t';
-            for (int j = 0; j < sGraph.size(); ++j)  {
-                degree += sGraph[i][j];
+        PrintDegrees<false>(writer);
+    }
+    Convert(mode);
+}
+
+/**
+ * Ядро подсчета степеней/полустепеней по матрице смежности.
+ * Для орграфа полустепени захода накапливаются за тот же построчный проход, что и полустепени исхода,
+ * а для неорграфа они не считаются вовсе.
+ * @tparam Oriented ориентированность графа.
+ * @param stream буферизированный вывод, в который нужно выводить информацию.
+ */
+template<bool Oriented>
+void Graph::PrintDegrees(OutputWriter& stream)  {
+    std::vector<int> outDegree(sGraph.size(), 0);
+    std::vector<int> inDegree(Oriented ? sGraph.size() : 0, 0);
+    for (size_t i = 0; i < sGraph.size(); ++i)  {
+        for (size_t j = 0; j < sGraph.size(); ++j)  {
+            outDegree[i] += sGraph[i][j];
+            if constexpr (Oriented)  {
+                inDegree[j] += sGraph[i][j];
             }
-            stream << "Degree: " << degree << '\n';
         }
     }
-    Convert(mode);
+    for (size_t i = 0; i < sGraph.size(); ++i)  {
+        stream << (i+1) << '\t';
+        if constexpr (Oriented)  {
+            stream << "In-degree: " << inDegree[i] << '\t' << "Out-degree: " << outDegree[i] << '\n';
+        }  else  {
+            stream << "Degree: " << outDegree[i] << '\n';
+        }
+    }
 }
 
 /**
  * Функция производит подсчет суммарного количества ребер/дуг и выводит его в поток.
- * @param oriented ориентированность графа.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::CountArcEdges(bool oriented, std::ostream& stream) {
+void Graph::CountArcEdges(std::ostream& stream) {
     // Произвожу подсчет в списке ребер, поэтому конвертирую в него, подсчитываю и после конвертирую обратно.
     int mode = sCurrentMode;
     Convert(4);
-    if (oriented)  {
+    if (sOriented)  {
         stream << "Arcs: " << sGraph.size() << '\n';
     }  else  {
+        // Неорграф хранится с зеркальными дугами, поэтому каждое ребро учтено дважды.
         stream << "Edges: " << sGraph.size() / 2 << '\n';
     }
     Convert(mode);
@@ -242,18 +405,19 @@ void Graph::CountArcEdges(bool oriented, std::ostream& stream) {
  */
 void Graph::Print(int outputMode, std::ostream& stream) {
     Convert(outputMode);
+    OutputWriter writer(stream);
     if (outputMode == 1 || outputMode == 2)  {
         for (size_t i = 0; i < sGraph[0].size(); ++i)  {
-            stream << '\t' << (i+1);
+            writer << '\t' << (i+1);
         }
-        stream << '\n';
+        writer << '\n';
     }
     for (size_t i = 0; i < sGraph.size(); ++i)  {
-        stream << (i+1) << '\t';
+        writer << (i+1) << '\t';
         for (int j : sGraph[i])  {
-            stream << j << '\t';
+            writer << j << '\t';
         }
-        stream << '\n';
+        writer << '\n';
     }
 }
 
@@ -264,7 +428,7 @@ void Graph::Print(int outputMode, std::ostream& stream) {
  * @param stream поток, в который нужно выводить информацию.
  * @param flag индикатор, что мы находимся у корня компоненты связности.
  */
-void Graph::RecursiveDFS(int start, std::unordered_set<int>& visited, std::ostream& stream, bool flag) {
+void Graph::RecursiveDFS(int start, std::unordered_set<int>& visited, OutputWriter& stream, bool flag) {
     visited.insert(start);
     stream << start << " ";
     for (int & i : sGraph[start-1])  {
@@ -291,7 +455,7 @@ void Graph::RecursiveDFS(int start, std::unordered_set<int>& visited, std::ostre
  * @param stack стэк с вершинами, которые нужно обойти.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::DFS(int& start, std::unordered_set<int> &visited, std::stack<int>& stack, std::ostream& stream)  {
+void Graph::DFS(int& start, std::unordered_set<int> &visited, std::stack<int>& stack, OutputWriter& stream)  {
     while (!stack.empty())  {
         if (!visited.contains(stack.top()))  {
             visited.insert(stack.top());
@@ -316,7 +480,7 @@ void Graph::DFS(int& start, std::unordered_set<int> &visited, std::stack<int>& s
  * @param visited множество, в котором содержатся посещенные вершины.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::NonRecursiveDFS(int start, std::unordered_set<int> &visited, std::ostream& stream) {
+void Graph::NonRecursiveDFS(int start, std::unordered_set<int> &visited, OutputWriter& stream) {
     visited.insert(start);
     std::stack<int> stack;
     stream << start << " ";
@@ -347,7 +511,7 @@ void Graph::NonRecursiveDFS(int start, std::unordered_set<int> &visited, std::os
  * @param queue очередь с вершинами, которые нужно обойти.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::BFS(int &start, std::unordered_set<int> &visited, std::queue<int> &queue, std::ostream &stream) {
+void Graph::BFS(int &start, std::unordered_set<int> &visited, std::queue<int> &queue, OutputWriter& stream) {
     while (!queue.empty())  {
         if (!visited.contains(queue.front()))  {
             visited.insert(queue.front());
@@ -372,7 +536,7 @@ void Graph::BFS(int &start, std::unordered_set<int> &visited, std::queue<int> &q
  * @param visited множество, в котором содержатся посещенные вершины.
  * @param stream поток, в который нужно выводить информацию.
  */
-void Graph::NonRecursiveBFS(int start, std::unordered_set<int> &visited, std::ostream& stream) {
+void Graph::NonRecursiveBFS(int start, std::unordered_set<int> &visited, OutputWriter& stream) {
     visited.insert(start);
     std::queue<int> queue;
     stream << start << " ";
@@ -415,18 +579,255 @@ void Graph::GraphSearch(int start, int searchMode, std::ostream& stream)  {
         Convert(mode);
         return;
     }
+    OutputWriter writer(stream);
     switch (searchMode) {
         case 4:
-            RecursiveDFS(start, visited, stream, true);
+            RecursiveDFS(start, visited, writer, true);
             break;
         case 5:
-            NonRecursiveDFS(start, visited, stream);
+            NonRecursiveDFS(start, visited, writer);
             break;
         case 6:
-            NonRecursiveBFS(start, visited, stream);
+            NonRecursiveBFS(start, visited, writer);
             break;
         default:
             break;
     }
     Convert(mode);
-}
\ No newline at end of file
+}
+
+/**
+ * Функция находит кратчайшие пути из вершины во все вершины графа и выводит для каждой вершины расстояние
+ * и сам путь. Длина дуги - ее вес, а без заданных весов каждая дуга имеет длину 1. Во взвешенном графе
+ * пути ищет алгоритм Дейкстры, если дуги не делятся между потоками, иначе - параллельный delta-stepping.
+ * @param start вершина, из которой ищутся пути.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::Distances(int start, std::ostream& stream)  {
+    auto graph = Snapshot();
+    if (start < 1 || graph->Verts() < size_t(start))  {
+        std::cout << "Error: invalid start point, try again!\n";
+        return;
+    }
+    OutputWriter writer(stream);
+    auto print = [&](const auto& paths)  {
+        for (uint32_t v = 0; v < graph->Verts(); ++v)  {
+            writer << (v+1) << '\t';
+            if (!paths.Reachable(v))  {
+                writer << "Unreachable\n";
+                continue;
+            }
+            writer << "Distance: " << paths.distances[v] << '\t' << "Path:";
+            for (uint32_t u : paths.PathTo(v))  {
+                writer << ' ' << (u+1);
+            }
+            writer << '\n';
+        }
+    };
+    if (!IsWeighted())  {
+        print(DeltaStepping(*graph, uint32_t(start - 1)));
+        return;
+    }
+    auto weighted = ToCsr<uint32_t, int64_t>();
+    if (Parallel::ThreadCount(weighted.Arcs()) > 1)  {
+        print(DeltaStepping(weighted, uint32_t(start - 1)));
+    }  else  {
+        print(Dijkstra(weighted, uint32_t(start - 1)));
+    }
+}
+
+/**
+ * Функция находит кратчайшие расстояния между всеми парами вершин и выводит их в виде матрицы,
+ * недостижимые вершины отмечаются прочерком. Длина дуги - ее вес, а без заданных весов каждая дуга
+ * имеет длину 1.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::AllDistances(std::ostream& stream)  {
+    OutputWriter writer(stream);
+    auto print = [&](const auto& matrix)  {
+        for (size_t i = 0; i < matrix.verts; ++i)  {
+            writer << '\t' << (i+1);
+        }
+        writer << '\n';
+        for (size_t i = 0; i < matrix.verts; ++i)  {
+            writer << (i+1) << '\t';
+            for (size_t j = 0; j < matrix.verts; ++j)  {
+                if (matrix.Reachable(i, j))  {
+                    writer << matrix(i, j) << '\t';
+                }  else  {
+                    writer << "-\t";
+                }
+            }
+            writer << '\n';
+        }
+    };
+    if (IsWeighted())  {
+        print(AllPairsShortestPaths(ToCsr<uint32_t, int64_t>()));
+    }  else  {
+        print(AllPairsShortestPaths(*Snapshot()));
+    }
+}
+
+/**
+ * Функция строит транзитивное замыкание графа и выводит его в виде матрицы:
+ * 1 - из вершины строки есть путь в вершину столбца, 0 - нет.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintClosure(std::ostream& stream)  {
+    auto graph = Snapshot();
+    OutputWriter writer(stream);
+    auto print = [&](size_t verts, const auto& reaches)  {
+        for (size_t i = 0; i < verts; ++i)  {
+            writer << '\t' << (i+1);
+        }
+        writer << '\n';
+        for (size_t i = 0; i < verts; ++i)  {
+            writer << (i+1) << '\t';
+            for (size_t j = 0; j < verts; ++j)  {
+                writer << int(reaches(i, j)) << '\t';
+            }
+            writer << '\n';
+        }
+    };
+    // Граф, который помещается в одно 64-битное слово на строку, замыкается без выделения памяти.
+    if (graph->Verts() <= 64)  {
+        auto closure = SmallGraph<64>::FromCsr(*graph).TransitiveClosure();
+        print(closure.Verts(), [&](size_t i, size_t j)  {
+            return closure.HasArc(i, j);
+        });
+    }  else  {
+        auto matrix = ReachabilityMatrix::Build(*graph);
+        print(matrix.Verts(), [&](size_t i, size_t j)  {
+            return matrix.Reaches(i, j);
+        });
+    }
+}
+
+/**
+ * Функция подсчитывает треугольники и коэффициенты кластеризации и выводит их в поток.
+ * Граф рассматривается как простой неориентированный.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintTriangles(std::ostream& stream)  {
+    auto stats = CountTriangles(*Snapshot());
+    OutputWriter writer(stream);
+    for (size_t i = 0; i < stats.perVertex.size(); ++i)  {
+        writer << (i+1) << '\t' << "Triangles: " << stats.perVertex[i] << '\t'
+               << "Clustering: " << stats.clustering[i] << '\n';
+    }
+    writer << "Triangles: " << stats.total << '\n' << "Average clustering: " << stats.averageClustering << '\n'
+           << "Transitivity: " << stats.transitivity << '\n';
+}
+
+/**
+ * Функция вычисляет PageRank вершин и выводит ранги в поток.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintPageRank(std::ostream& stream)  {
+    auto result = PageRank(*Snapshot());
+    OutputWriter writer(stream);
+    for (size_t i = 0; i < result.ranks.size(); ++i)  {
+        writer << (i+1) << '\t' << "Rank: " << result.ranks[i] << '\n';
+    }
+    writer << "Iterations: " << result.iterations << '\n';
+}
+
+/**
+ * Функция выводит вершины орграфа в топологическом порядке, либо цикл, если граф не ацикличен.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintTopologicalOrder(std::ostream& stream)  {
+    if (!sOriented)  {
+        std::cout << "Error: topological order exists only for oriented graphs!\n";
+        return;
+    }
+    auto result = TopologicalSort(*Snapshot());
+    OutputWriter writer(stream);
+    const auto& vertices = result.IsDag() ? result.order : result.cycle;
+    writer << (result.IsDag() ? "Order:" : "Cycle:");
+    for (uint32_t v : vertices)  {
+        writer << ' ' << (v+1);
+    }
+    if (!result.IsDag())  {
+        writer << ' ' << (vertices.front()+1);
+    }
+    writer << '\n';
+}
+
+/**
+ * Функция строит минимальный остовный лес неорграфа и выводит его ребра с весами в виде списка ребер.
+ * Если ребер мало и цикл не делится между потоками, используется последовательный алгоритм Краскала,
+ * иначе - параллельный алгоритм Борувки. Оба алгоритма при равных весах выбирают ребро с меньшими концами,
+ * поэтому лес не зависит от количества потоков.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintSpanningForest(std::ostream& stream)  {
+    if (sOriented)  {
+        std::cout << "Error: spanning forest is built only for not oriented graphs!\n";
+        return;
+    }
+    auto graph = ToCsr<uint32_t, uint32_t, false>();
+    auto forest = Parallel::ThreadCount(graph.Arcs()) > 1 ? Boruvka(graph) : Kruskal(graph);
+    for (auto& edge : forest.edges)  {
+        if (edge.to < edge.from)  {
+            std::swap(edge.from, edge.to);
+        }
+    }
+    std::sort(forest.edges.begin(), forest.edges.end(), [](const auto& a, const auto& b)  {
+        return std::tuple(a.weight, a.from, a.to) < std::tuple(b.weight, b.from, b.to);
+    });
+    OutputWriter writer(stream);
+    for (size_t i = 0; i < forest.edges.size(); ++i)  {
+        writer << (i+1) << '\t' << (forest.edges[i].from+1) << '\t' << (forest.edges[i].to+1) << '\t'
+               << forest.edges[i].weight << '\n';
+    }
+    writer << "Weight: " << forest.total << '\n';
+}
+
+/**
+ * Функция проверяет двудольность неорграфа и выводит наибольшее паросочетание,
+ * либо нечетный цикл, если граф не двудолен.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintMatching(std::ostream& stream)  {
+    if (sOriented)  {
+        std::cout << "Error: matching is built only for not oriented graphs!\n";
+        return;
+    }
+    auto graph = ToCsr<uint32_t, void, false>();
+    auto coloring = BipartiteColoring(graph);
+    OutputWriter writer(stream);
+    if (!coloring.IsBipartite())  {
+        writer << "Odd cycle:";
+        for (uint32_t v : coloring.oddCycle)  {
+            writer << ' ' << (v+1);
+        }
+        writer << ' ' << (coloring.oddCycle.front()+1) << '\n';
+        return;
+    }
+    auto matching = HopcroftKarp(graph, coloring);
+    writer << "Matching: " << matching.size << '\n';
+    for (uint32_t v = 0; v < graph.Verts(); ++v)  {
+        if (coloring.color[v] == 0 && matching.mate[v] != matching.kNone)  {
+            writer << (v+1) << '\t' << (matching.mate[v]+1) << '\n';
+        }
+    }
+}
+
+/**
+ * Функция раскладывает граф на k-ядра и выводит ядерные числа вершин и порядок вырождения.
+ * Орграф рассматривается как неориентированный.
+ * @param stream поток, в который нужно выводить информацию.
+ */
+void Graph::PrintCores(std::ostream& stream)  {
+    auto cores = sOriented ? ParallelKCores(*Snapshot()) : ParallelKCores(ToCsr<uint32_t, void, false>());
+    OutputWriter writer(stream);
+    for (size_t i = 0; i < cores.core.size(); ++i)  {
+        writer << (i+1) << '\t' << "Core: " << cores.core[i] << '\n';
+    }
+    writer << "Degeneracy: " << cores.degeneracy << '\n' << "Order:";
+    for (uint32_t v : cores.order)  {
+        writer << ' ' << (v+1);
+    }
+    writer << '\n';
+}
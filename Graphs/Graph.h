@@ -2,10 +2,15 @@
 #define GRAPHS_GRAPH_H
 
 #include <vector>
+#include <map>
 #include <stack>
 #include <queue>
 #include <iostream>
 #include <unordered_set>
+#include <memory>
+#include "CsrGraph.h"
+#include "Parallel.h"
+#include "OutputWriter.h"
 
 /**
  * Класс, представляющий собой граф и операции доступные с ним.
@@ -16,10 +21,17 @@ private:
     inline static std::vector<std::vector<int>> sGraph;
     // Текущее представление графа.
     inline static int sCurrentMode = 0;
+    // Ориентированность заданного графа.
+    inline static bool sOriented = true;
+    // Веса дуг (начало, конец) с нумерацией с 1, дуги без веса имеют вес 1.
+    inline static std::map<std::pair<int, int>, int64_t> sWeights;
+    // Ядро подсчета степеней/полустепеней вершин, отдельное для орграфа и неорграфа.
+    template<bool Oriented>
+    static void PrintDegrees(OutputWriter& stream);
 public:
     inline static size_t sVerts;
     // Универсальный конструктор для графа в любом представлении.
-    explicit Graph (std::vector<std::vector<int>> matrix, int mode);
+    explicit Graph (std::vector<std::vector<int>> matrix, int mode, bool oriented);
     // Конвертер из матрицы смежности в матрицу инцидентности.
     static void FromAdjacencyToIncidenceMatrix();
     // Конвертер из матрицы смежности в список смежности.
@@ -30,31 +42,122 @@ public:
     static void FromIncidenceToAdjacencyMatrix();
     // Конвертер из списка смежности в матрицу смежности.
     static void FromAdjacencyListToMatrix();
+    // Конвертер из списка смежности в список ребер.
+    static void FromAdjacencyListToEdgeList();
     // Конвертер из списка ребер в матрицу смежности.
     static void FromEdgeListToAdjacencyMatrix();
+    // Конвертер из списка ребер в список смежности.
+    static void FromEdgeListToAdjacencyList();
     // Конвертирует граф в другое представление, либо ничего не делает,
     // если выбрано представление, совпадающее с текущим.
     static void Convert(int outputMode);
     // Проверка пустой ли граф.
     static bool IsEmpty();
+    // Ориентированность заданного графа.
+    static bool IsOriented();
+    // Задание весов дуг.
+    static void SetWeights(std::map<std::pair<int, int>, int64_t> weights);
+    // Заданы ли веса дуг.
+    static bool IsWeighted();
+    // Вызов функции с ориентированностью графа в виде константы времени компиляции.
+    template<typename Func>
+    static auto WithOrientation(Func&& func);
+    // Неизменяемый снимок графа для параллельных запросов.
+    static std::shared_ptr<const CsrGraph<>> Snapshot();
+    // Построение компактного представления графа (CSR).
+    template<typename Vertex = uint32_t, typename Weight = void, bool Directed = true>
+    static CsrGraph<Vertex, Weight, Directed> ToCsr();
     // Подсчет степеней/полустепеней вершин.
-    static void VerticesDegree(bool oriented, std::ostream& stream);
+    static void VerticesDegree(std::ostream& stream);
     // Подсчет суммарного количества ребер/дуг.
-    static void CountArcEdges(bool oriented, std::ostream& stream);
+    static void CountArcEdges(std::ostream& stream);
     // Вызов конвертера и вывод графа в полученном представлении в поток.
     static void Print(int outputMode, std::ostream& stream);
     // Рекурсивный обход в глубину.
-    static void RecursiveDFS(int start, std::unordered_set<int>& visited, std::ostream& stream, bool flag);
+    static void RecursiveDFS(int start, std::unordered_set<int>& visited, OutputWriter& stream, bool flag);
     // Вспомогательная функция для нерекурсивного обхода графа в глубину.
-    static void DFS(int& start, std::unordered_set<int> &visited, std::stack<int>& stack, std::ostream& stream);
+    static void DFS(int& start, std::unordered_set<int> &visited, std::stack<int>& stack, OutputWriter& stream);
     // Нерекурсивный обход в глубину.
-    static void NonRecursiveDFS(int start, std::unordered_set<int>& visited, std::ostream& stream);
+    static void NonRecursiveDFS(int start, std::unordered_set<int>& visited, OutputWriter& stream);
     // Вспомогательная функция для нерекурсивного обхода графа в ширину.
-    static void BFS(int& start, std::unordered_set<int> &visited, std::queue<int>& queue, std::ostream& stream);
+    static void BFS(int& start, std::unordered_set<int> &visited, std::queue<int>& queue, OutputWriter& stream);
     // Рекурсивный обход в ширину.
-    static void NonRecursiveBFS(int start, std::unordered_set<int>& visited, std::ostream& stream);
+    static void NonRecursiveBFS(int start, std::unordered_set<int>& visited, OutputWriter& stream);
     // Функция для проверки корректности стартовой точки и запуска нужной функции обхода графа.
     static void GraphSearch(int start, int searchMode, std::ostream& stream);
+    // Кратчайшие пути из вершины во все вершины графа.
+    static void Distances(int start, std::ostream& stream);
+    // Кратчайшие расстояния между всеми парами вершин.
+    static void AllDistances(std::ostream& stream);
+    // Вывод транзитивного замыкания графа.
+    static void PrintClosure(std::ostream& stream);
+    // Подсчет треугольников и коэффициентов кластеризации.
+    static void PrintTriangles(std::ostream& stream);
+    // Вычисление PageRank вершин.
+    static void PrintPageRank(std::ostream& stream);
+    // Топологическая сортировка орграфа.
+    static void PrintTopologicalOrder(std::ostream& stream);
+    // Минимальный остовный лес неорграфа.
+    static void PrintSpanningForest(std::ostream& stream);
+    // Наибольшее паросочетание двудольного неорграфа.
+    static void PrintMatching(std::ostream& stream);
+    // Ядерные числа вершин и порядок вырождения.
+    static void PrintCores(std::ostream& stream);
 };
 
+/**
+ * Функция вызывает func с ориентированностью графа в виде std::bool_constant, чтобы ядра алгоритмов
+ * компилировались отдельно для орграфа и неорграфа, а проверка выполнялась один раз.
+ * @param func функция вида func(std::bool_constant<Oriented>{}).
+ * @return результат func.
+ */
+template<typename Func>
+auto Graph::WithOrientation(Func&& func)  {
+    if (sOriented)  {
+        return func(std::true_type{});
+    }
+    return func(std::false_type{});
+}
+
+/**
+ * Построение компактного представления графа (CSR) из списка смежности.
+ * Префиксные суммы длин списков дают начало каждого списка, после чего списки копируются параллельно.
+ * Во взвешенном представлении дуги получают заданные веса, а дуги без заданного веса - вес 1.
+ * Неорграф хранится с зеркальными дугами, поэтому его список смежности уже симметричен.
+ * @tparam Vertex тип номера вершины.
+ * @tparam Weight тип веса дуги, void - без весов.
+ * @tparam Directed ориентированность представления, для орграфа дополнительно строятся входящие дуги.
+ * @return граф в представлении CSR с нумерацией вершин с 0.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+CsrGraph<Vertex, Weight, Directed> Graph::ToCsr()  {
+    int mode = sCurrentMode;
+    Convert(3);
+    CsrGraph<Vertex, Weight, Directed> csr;
+    csr.offsets.assign(sGraph.size() + 1, 0);
+    for (size_t i = 0; i < sGraph.size(); ++i)  {
+        csr.offsets[i + 1] = csr.offsets[i] + sGraph[i].size();
+    }
+    csr.targets.resize(csr.offsets.back());
+    if constexpr (CsrGraph<Vertex, Weight, Directed>::kWeighted)  {
+        csr.weights.assign(csr.offsets.back(), Weight(1));
+    }
+    Parallel::For(sGraph.size(), [&](size_t begin, size_t end, size_t)  {
+        for (size_t i = begin; i < end; ++i)  {
+            for (size_t j = 0; j < sGraph[i].size(); ++j)  {
+                csr.targets[csr.offsets[i] + j] = Vertex(sGraph[i][j] - 1);
+                if constexpr (CsrGraph<Vertex, Weight, Directed>::kWeighted)  {
+                    auto weight = sWeights.find({int(i) + 1, sGraph[i][j]});
+                    if (weight != sWeights.end())  {
+                        csr.weights[csr.offsets[i] + j] = Weight(weight->second);
+                    }
+                }
+            }
+        }
+    });
+    csr.BuildIncoming();
+    Convert(mode);
+    return csr;
+}
+
 #endif //GRAPHS_GRAPH_H
@@ -0,0 +1,202 @@
+#ifndef GRAPHS_KCORE_H
+#define GRAPHS_KCORE_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+/**
+ * Разложение графа на k-ядра. k-ядро - наибольший подграф, в котором степень каждой вершины не меньше k,
+ * ядерное число вершины - наибольшее k, при котором она входит в k-ядро. Граф рассматривается как
+ * неориентированный мультиграф: у орграфа учитываются и исходящие, и входящие дуги, кратные дуги считаются
+ * каждая, петли не учитываются.
+ */
+template<typename Vertex>
+struct CoreDecomposition  {
+    // Ядерное число каждой вершины.
+    std::vector<Vertex> core;
+    // Порядок вырождения: вершины в порядке удаления, у каждой не больше degeneracy соседей правее нее.
+    std::vector<Vertex> order;
+    // Вырожденность графа - наибольшее ядерное число.
+    Vertex degeneracy = 0;
+};
+
+/**
+ * Степень вершины в неориентированном мультиграфе без петель.
+ * @param graph граф в представлении CSR.
+ * @param v вершина.
+ * @return степень вершины.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Vertex CoreDegree(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex v)  {
+    size_t degree = 0;
+    for (Vertex u : graph.Neighbors(v))  {
+        degree += u != v;
+    }
+    if constexpr (Directed)  {
+        for (Vertex u : graph.InNeighbors(v))  {
+            degree += u != v;
+        }
+    }
+    return Vertex(degree);
+}
+
+/**
+ * Обход соседей вершины в неориентированном мультиграфе. Для орграфа нужны входящие дуги (BuildIncoming).
+ * @param graph граф в представлении CSR.
+ * @param v вершина.
+ * @param visit функция, вызываемая для каждого соседа.
+ */
+template<typename Vertex, typename Weight, bool Directed, typename Func>
+void ForEachCoreNeighbor(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex v, const Func& visit)  {
+    for (Vertex u : graph.Neighbors(v))  {
+        visit(u);
+    }
+    if constexpr (Directed)  {
+        for (Vertex u : graph.InNeighbors(v))  {
+            visit(u);
+        }
+    }
+}
+
+/**
+ * Последовательное разложение на k-ядра алгоритмом Батагеля-Заверсника за O(V + E). Вершины лежат в массиве,
+ * отсортированном подсчетом по текущей степени, bin[d] - начало корзины степени d. Вершины удаляются слева
+ * направо; когда степень соседа уменьшается, он меняется местами с первой вершиной своей корзины, и граница
+ * корзины сдвигается на одну позицию, так что массив остается отсортированным. Кроме графа нужны четыре
+ * массива размера V: степени (в них же остаются ядерные числа), позиции, сам массив вершин (он же порядок
+ * вырождения) и корзины.
+ * @param graph граф в представлении CSR.
+ * @return ядерные числа и порядок вырождения.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+CoreDecomposition<Vertex> KCores(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    size_t verts = graph.Verts();
+    CoreDecomposition<Vertex> result;
+    std::vector<Vertex>& degree = result.core;
+    std::vector<Vertex>& order = result.order;
+    degree.resize(verts);
+    Vertex maxDegree = 0;
+    for (size_t v = 0; v < verts; ++v)  {
+        degree[v] = CoreDegree(graph, Vertex(v));
+        maxDegree = std::max(maxDegree, degree[v]);
+    }
+    std::vector<size_t> bin(size_t(maxDegree) + 1, 0);
+    for (Vertex d : degree)  {
+        ++bin[d];
+    }
+    size_t start = 0;
+    for (size_t& count : bin)  {
+        size_t size = count;
+        count = start;
+        start += size;
+    }
+    std::vector<size_t> position(verts);
+    order.resize(verts);
+    for (size_t v = 0; v < verts; ++v)  {
+        position[v] = bin[degree[v]]++;
+        order[position[v]] = Vertex(v);
+    }
+    for (size_t d = maxDegree; d > 0; --d)  {
+        bin[d] = bin[d - 1];
+    }
+    if (!bin.empty())  {
+        bin[0] = 0;
+    }
+    for (size_t i = 0; i < verts; ++i)  {
+        Vertex v = order[i];
+        ForEachCoreNeighbor(graph, v, [&](Vertex u)  {
+            if (degree[u] > degree[v])  {
+                Vertex d = degree[u];
+                size_t first = bin[d];
+                Vertex w = order[first];
+                if (u != w)  {
+                    std::swap(order[position[u]], order[first]);
+                    std::swap(position[u], position[w]);
+                }
+                ++bin[d];
+                --degree[u];
+            }
+        });
+        result.degeneracy = std::max(result.degeneracy, degree[v]);
+    }
+    return result;
+}
+
+/**
+ * Параллельное разложение на k-ядра послойным удалением. Для k = 0, 1, ... вершины со степенью k
+ * собираются параллельным проходом по массиву степеней и удаляются волнами: каждая волна параллельно уменьшает
+ * степени соседей, и соседи, чья степень дошла до k, образуют следующую волну. Степень соседа уменьшается
+ * атомарно, только пока она больше k; если конкурирующий поток уже опустил ее до k, вычитание откатывается.
+ * Степень вершины, удаленной на уровне k, больше не меняется и равна ее ядерному числу, поэтому отдельная
+ * отметка об удалении не нужна. Работа O(V * degeneracy / потоки + E), памяти - массив степеней, порядок и
+ * буферы волн.
+ * @param graph граф в представлении CSR.
+ * @return ядерные числа и порядок вырождения (внутри волны - в порядке блоков).
+ */
+template<typename Vertex, typename Weight, bool Directed>
+CoreDecomposition<Vertex> ParallelKCores(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    size_t verts = graph.Verts();
+    CoreDecomposition<Vertex> result;
+    std::vector<Vertex>& degree = result.core;
+    degree.resize(verts);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t v = begin; v < end; ++v)  {
+            degree[v] = CoreDegree(graph, Vertex(v));
+        }
+    });
+    result.order.reserve(verts);
+    std::vector<std::vector<Vertex>> buffers;
+    // Собирает в result.order вершины, которые блоки положили в свои буферы, и возвращает начало новой волны.
+    auto flush = [&]()  {
+        size_t first = result.order.size();
+        for (auto& buffer : buffers)  {
+            result.order.insert(result.order.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+        return first;
+    };
+    for (Vertex k = 0; result.order.size() < verts; ++k)  {
+        buffers.assign(Parallel::ThreadCount(verts), {});
+        Parallel::For(verts, [&](size_t begin, size_t end, size_t block)  {
+            for (size_t v = begin; v < end; ++v)  {
+                if (degree[v] == k)  {
+                    buffers[block].push_back(Vertex(v));
+                }
+            }
+        });
+        size_t first = flush();
+        if (first == result.order.size())  {
+            continue;
+        }
+        result.degeneracy = k;
+        while (first < result.order.size())  {
+            size_t last = result.order.size();
+            buffers.assign(Parallel::ThreadCount(last - first), {});
+            Parallel::For(last - first, [&](size_t begin, size_t end, size_t block)  {
+                for (size_t i = first + begin; i < first + end; ++i)  {
+                    ForEachCoreNeighbor(graph, result.order[i], [&](Vertex u)  {
+                        std::atomic_ref<Vertex> target(degree[u]);
+                        if (target.load(std::memory_order_relaxed) <= k)  {
+                            return;
+                        }
+                        Vertex previous = target.fetch_sub(1, std::memory_order_relaxed);
+                        if (previous == k + 1)  {
+                            buffers[block].push_back(u);
+                        }  else if (previous <= k)  {
+                            target.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    });
+                }
+            });
+            first = last;
+            flush();
+        }
+    }
+    return result;
+}
+
+#endif //GRAPHS_KCORE_H
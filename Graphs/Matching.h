@@ -0,0 +1,123 @@
+#ifndef GRAPHS_MATCHING_H
+#define GRAPHS_MATCHING_H
+
+#include <vector>
+#include <limits>
+#include "CsrGraph.h"
+#include "Traversal.h"
+
+/**
+ * Паросочетание: пара каждой вершины (kNone для свободных) и количество ребер.
+ */
+template<typename Vertex>
+struct Matching  {
+    static constexpr Vertex kNone = std::numeric_limits<Vertex>::max();
+    std::vector<Vertex> mate;
+    size_t size = 0;
+};
+
+/**
+ * Наибольшее паросочетание в двудольном графе алгоритмом Хопкрофта-Карпа за O(E * sqrt(V)).
+ * Доли определяются раскраской BipartiteColoring. Каждая фаза строит слои обходом в ширину от свободных вершин
+ * доли 0 и находит максимальный набор непересекающихся кратчайших увеличивающих путей обходом в глубину
+ * на явном стеке с указателями текущих дуг, поэтому глубина пути не ограничена размером стека вызовов.
+ * @param graph неорграф в представлении CSR.
+ * @param coloring раскраска графа в два цвета.
+ * @return наибольшее паросочетание.
+ */
+template<typename Vertex, typename Weight>
+Matching<Vertex> HopcroftKarp(const CsrGraph<Vertex, Weight, false>& graph, const TwoColoring<Vertex>& coloring)  {
+    constexpr Vertex none = Matching<Vertex>::kNone;
+    constexpr size_t unreached = std::numeric_limits<size_t>::max();
+    size_t verts = graph.Verts();
+    Matching<Vertex> result;
+    result.mate.assign(verts, none);
+    std::vector<Vertex> left, queue, stack;
+    for (size_t v = 0; v < verts; ++v)  {
+        if (coloring.color[v] == 0)  {
+            left.push_back(Vertex(v));
+        }
+    }
+    std::vector<size_t> layer(verts), current(verts);
+    while (true)  {
+        // Слои левых вершин: свободные на слое 0, далее через ребро вне паросочетания и ребро паросочетания.
+        // Слой last - первый, из которого видна свободная правая вершина; кратчайшие увеличивающие пути
+        // заканчиваются на нем, поэтому дальше слои не строятся.
+        size_t last = unreached;
+        queue.clear();
+        for (Vertex u : left)  {
+            layer[u] = result.mate[u] == none ? 0 : unreached;
+            if (layer[u] == 0)  {
+                queue.push_back(u);
+            }
+        }
+        for (size_t head = 0; head < queue.size() && layer[queue[head]] <= last; ++head)  {
+            Vertex u = queue[head];
+            for (Vertex w : graph.Neighbors(u))  {
+                Vertex next = result.mate[w];
+                if (next == none)  {
+                    last = layer[u];
+                }  else if (layer[next] == unreached)  {
+                    layer[next] = layer[u] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+        if (last == unreached)  {
+            return result;
+        }
+        for (Vertex u : left)  {
+            current[u] = graph.offsets[u];
+        }
+        for (Vertex start : left)  {
+            if (result.mate[start] != none)  {
+                continue;
+            }
+            stack.assign(1, start);
+            while (!stack.empty())  {
+                Vertex u = stack.back();
+                if (current[u] == graph.offsets[u + 1])  {
+                    // Из u нет увеличивающего пути в этой фазе.
+                    layer[u] = unreached;
+                    stack.pop_back();
+                    continue;
+                }
+                Vertex w = graph.targets[current[u]];
+                Vertex next = result.mate[w];
+                if (next == none && layer[u] == last)  {
+                    // Увеличение вдоль стека: каждая вершина стека берет в пару вершину своей текущей дуги.
+                    for (Vertex x : stack)  {
+                        Vertex y = graph.targets[current[x]];
+                        result.mate[x] = y;
+                        result.mate[y] = x;
+                    }
+                    ++result.size;
+                    break;
+                }
+                if (next != none && layer[u] < last && layer[next] == layer[u] + 1)  {
+                    stack.push_back(next);
+                }  else  {
+                    ++current[u];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Наибольшее паросочетание двудольного графа с проверкой двудольности.
+ * @param graph неорграф в представлении CSR.
+ * @return паросочетание, либо пустое паросочетание, если граф не двудолен.
+ */
+template<typename Vertex, typename Weight>
+Matching<Vertex> HopcroftKarp(const CsrGraph<Vertex, Weight, false>& graph)  {
+    auto coloring = BipartiteColoring(graph);
+    if (!coloring.IsBipartite())  {
+        Matching<Vertex> result;
+        result.mate.assign(graph.Verts(), Matching<Vertex>::kNone);
+        return result;
+    }
+    return HopcroftKarp(graph, coloring);
+}
+
+#endif //GRAPHS_MATCHING_H
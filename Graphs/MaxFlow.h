@@ -0,0 +1,355 @@
+#ifndef GRAPHS_MAXFLOW_H
+#define GRAPHS_MAXFLOW_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include "CsrGraph.h"
+
+// Тип пропускной способности: вес дуги, для невзвешенного графа - 64-битное целое (каждая дуга пропускает 1).
+template<typename Weight>
+using CapacityType = std::conditional_t<std::is_void_v<Weight>, uint64_t, Weight>;
+
+/**
+ * Остаточная сеть в представлении CSR. Для каждой дуги графа хранятся прямая дуга и обратная дуга
+ * с нулевой пропускной способностью, reverse[a] - индекс парной дуги, поэтому проталкивание потока
+ * по дуге - это два обращения по индексам без поиска.
+ */
+template<typename Vertex, typename Capacity>
+struct ResidualGraph  {
+    std::vector<size_t> offsets;
+    std::vector<Vertex> targets;
+    // Остаточная пропускная способность.
+    std::vector<Capacity> capacity;
+    // Индекс парной дуги.
+    std::vector<size_t> reverse;
+    // Индекс прямой дуги для каждой дуги исходного графа.
+    std::vector<size_t> forward;
+
+    // Количество вершин.
+    [[nodiscard]] size_t Verts() const  {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    /**
+     * Построение остаточной сети по графу подсчетом степеней и префиксными суммами.
+     * @param graph граф в представлении CSR, веса - пропускные способности.
+     * @return остаточная сеть без потока.
+     */
+    template<typename Weight, bool Directed>
+    static ResidualGraph FromCsr(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+        size_t verts = graph.Verts();
+        ResidualGraph residual;
+        residual.offsets.assign(verts + 1, 0);
+        for (size_t v = 0; v < verts; ++v)  {
+            residual.offsets[v + 1] += graph.Degree(Vertex(v));
+            for (Vertex to : graph.Neighbors(Vertex(v)))  {
+                ++residual.offsets[size_t(to) + 1];
+            }
+        }
+        for (size_t v = 0; v < verts; ++v)  {
+            residual.offsets[v + 1] += residual.offsets[v];
+        }
+        std::vector<size_t> position(residual.offsets.begin(), residual.offsets.end() - 1);
+        residual.targets.resize(residual.offsets.back());
+        residual.capacity.assign(residual.offsets.back(), 0);
+        residual.reverse.resize(residual.offsets.back());
+        residual.forward.resize(graph.Arcs());
+        for (size_t v = 0; v < verts; ++v)  {
+            for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+                Vertex to = graph.targets[arc];
+                size_t direct = position[v]++, back = position[to]++;
+                residual.targets[direct] = to;
+                residual.targets[back] = Vertex(v);
+                residual.capacity[direct] = Capacity(graph.WeightOf(arc));
+                residual.reverse[direct] = back;
+                residual.reverse[back] = direct;
+                residual.forward[arc] = direct;
+            }
+        }
+        return residual;
+    }
+};
+
+/**
+ * Максимальный поток и минимальный разрез.
+ */
+template<typename Capacity>
+struct FlowResult  {
+    // Величина потока.
+    Capacity value = 0;
+    // Поток по каждой дуге исходного графа.
+    std::vector<Capacity> flow;
+    // Доля разреза: 1 для вершин, достижимых из истока в остаточной сети.
+    std::vector<char> sourceSide;
+};
+
+/**
+ * Поток по дугам и минимальный разрез по остаточной сети после вычисления потока.
+ * @param graph исходный граф.
+ * @param residual остаточная сеть с максимальным потоком.
+ * @param source исток.
+ * @param value величина потока.
+ * @return результат.
+ */
+template<typename Vertex, typename Weight, bool Directed, typename Capacity>
+FlowResult<Capacity> CollectFlow(const CsrGraph<Vertex, Weight, Directed>& graph,
+                                 const ResidualGraph<Vertex, Capacity>& residual, Vertex source, Capacity value)  {
+    FlowResult<Capacity> result;
+    result.value = value;
+    result.flow.resize(graph.Arcs());
+    for (size_t arc = 0; arc < graph.Arcs(); ++arc)  {
+        result.flow[arc] = Capacity(graph.WeightOf(arc)) - residual.capacity[residual.forward[arc]];
+    }
+    result.sourceSide.assign(residual.Verts(), 0);
+    std::vector<Vertex> queue = {source};
+    result.sourceSide[source] = 1;
+    for (size_t head = 0; head < queue.size(); ++head)  {
+        Vertex v = queue[head];
+        for (size_t a = residual.offsets[v]; a < residual.offsets[v + 1]; ++a)  {
+            if (residual.capacity[a] > 0 && !result.sourceSide[residual.targets[a]])  {
+                result.sourceSide[residual.targets[a]] = 1;
+                queue.push_back(residual.targets[a]);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Проталкивание предпотока с выбором активной вершины наибольшей высоты.
+ * Высоты периодически пересчитываются точно обходом в ширину от стока по остаточной сети (global relabeling),
+ * а если на какой-то высоте не осталось вершин, все вершины выше нее отрезаны от стока и сразу поднимаются
+ * до высоты V (gap heuristic). Первая фаза строит максимальный предпоток, вторая той же процедурой возвращает
+ * лишний поток в исток, после чего предпоток становится потоком.
+ * @param graph граф в представлении CSR, веса - пропускные способности (неотрицательные, знакового типа).
+ * @param source исток.
+ * @param sink сток.
+ * @return максимальный поток и минимальный разрез.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+FlowResult<CapacityType<Weight>> PushRelabel(const CsrGraph<Vertex, Weight, Directed>& graph,
+                                             Vertex source, Vertex sink)  {
+    using Capacity = CapacityType<Weight>;
+    // Начальные проталкивания делают избыток истока отрицательным.
+    static_assert(!std::is_void_v<Weight> && std::is_signed_v<Capacity>,
+                  "push-relabel needs signed capacities, use Dinic for unit capacities");
+    auto residual = ResidualGraph<Vertex, Capacity>::FromCsr(graph);
+    size_t verts = residual.Verts();
+    std::vector<Capacity> excess(verts, 0);
+    std::vector<size_t> height(verts), current(verts), count(verts + 1);
+    std::vector<std::vector<Vertex>> active(verts);
+    std::vector<Vertex> queue;
+    if (source == sink)  {
+        return CollectFlow(graph, residual, source, Capacity(0));
+    }
+    auto push = [&](size_t a, Capacity amount, Vertex from)  {
+        residual.capacity[a] -= amount;
+        residual.capacity[residual.reverse[a]] += amount;
+        excess[from] -= amount;
+        excess[residual.targets[a]] += amount;
+    };
+    for (size_t a = residual.offsets[source]; a < residual.offsets[source + 1]; ++a)  {
+        if (residual.capacity[a] > 0)  {
+            push(a, residual.capacity[a], source);
+        }
+    }
+    // Одна фаза: поток из вершин с избытком проталкивается в target, вершина blocked не участвует.
+    auto phase = [&](Vertex target, Vertex blocked)  {
+        size_t highest = 0, relabels = 0;
+        auto activate = [&](Vertex v)  {
+            if (v != target && v != blocked && height[v] < verts && excess[v] > 0)  {
+                active[height[v]].push_back(v);
+                highest = std::max(highest, height[v]);
+            }
+        };
+        // Точные высоты - расстояния до target в остаточной сети, недостижимые вершины получают высоту V.
+        auto globalRelabel = [&]  {
+            std::fill(height.begin(), height.end(), verts);
+            std::fill(count.begin(), count.end(), 0);
+            for (auto& bucket : active)  {
+                bucket.clear();
+            }
+            height[target] = 0;
+            queue.assign(1, target);
+            for (size_t head = 0; head < queue.size(); ++head)  {
+                Vertex v = queue[head];
+                for (size_t a = residual.offsets[v]; a < residual.offsets[v + 1]; ++a)  {
+                    Vertex from = residual.targets[a];
+                    if (from != blocked && height[from] == verts && residual.capacity[residual.reverse[a]] > 0)  {
+                        height[from] = height[v] + 1;
+                        queue.push_back(from);
+                    }
+                }
+            }
+            highest = 0;
+            for (size_t v = 0; v < verts; ++v)  {
+                ++count[height[v]];
+                current[v] = residual.offsets[v];
+                activate(Vertex(v));
+            }
+            relabels = 0;
+        };
+        globalRelabel();
+        while (true)  {
+            while (highest > 0 && active[highest].empty())  {
+                --highest;
+            }
+            if (active[highest].empty())  {
+                return;
+            }
+            Vertex v = active[highest].back();
+            active[highest].pop_back();
+            // Запись могла устареть после подъема вершины эвристикой разрыва.
+            if (height[v] != highest || excess[v] <= 0)  {
+                continue;
+            }
+            while (excess[v] > 0 && height[v] < verts)  {
+                if (current[v] == residual.offsets[v + 1])  {
+                    size_t old = height[v], next = verts;
+                    for (size_t a = residual.offsets[v]; a < residual.offsets[v + 1]; ++a)  {
+                        if (residual.capacity[a] > 0)  {
+                            next = std::min(next, height[residual.targets[a]] + 1);
+                        }
+                    }
+                    --count[old];
+                    if (count[old] == 0)  {
+                        // Разрыв: вершины выше old больше не достигают target.
+                        for (size_t u = 0; u < verts; ++u)  {
+                            if (old < height[u] && height[u] < verts)  {
+                                --count[height[u]];
+                                height[u] = verts;
+                                ++count[verts];
+                            }
+                        }
+                        next = verts;
+                    }
+                    height[v] = std::min(next, verts);
+                    ++count[height[v]];
+                    current[v] = residual.offsets[v];
+                    ++relabels;
+                    continue;
+                }
+                size_t a = current[v];
+                Vertex to = residual.targets[a];
+                if (residual.capacity[a] > 0 && height[v] == height[to] + 1)  {
+                    bool idle = excess[to] <= 0;
+                    push(a, std::min(excess[v], residual.capacity[a]), v);
+                    if (idle)  {
+                        activate(to);
+                    }
+                }  else  {
+                    ++current[v];
+                }
+            }
+            if (relabels >= verts)  {
+                globalRelabel();
+            }
+        }
+    };
+    phase(sink, source);
+    Capacity value = excess[sink];
+    phase(source, sink);
+    return CollectFlow(graph, residual, source, value);
+}
+
+/**
+ * Алгоритм Диница: слоистая сеть обходом в ширину от истока и блокирующий поток нерекурсивным обходом
+ * в глубину с указателем текущей дуги. Для единичных пропускных способностей работает за O(E * sqrt(E)).
+ * @param graph граф в представлении CSR, веса - пропускные способности (неотрицательные).
+ * @param source исток.
+ * @param sink сток.
+ * @return максимальный поток и минимальный разрез.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+FlowResult<CapacityType<Weight>> Dinic(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex source, Vertex sink)  {
+    using Capacity = CapacityType<Weight>;
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    auto residual = ResidualGraph<Vertex, Capacity>::FromCsr(graph);
+    size_t verts = residual.Verts();
+    std::vector<size_t> level(verts), current(verts);
+    std::vector<Vertex> queue;
+    // Путь по дугам от истока.
+    std::vector<size_t> path;
+    Capacity value = 0;
+    while (source != sink)  {
+        std::fill(level.begin(), level.end(), none);
+        level[source] = 0;
+        queue.assign(1, source);
+        for (size_t head = 0; head < queue.size(); ++head)  {
+            Vertex v = queue[head];
+            for (size_t a = residual.offsets[v]; a < residual.offsets[v + 1]; ++a)  {
+                if (residual.capacity[a] > 0 && level[residual.targets[a]] == none)  {
+                    level[residual.targets[a]] = level[v] + 1;
+                    queue.push_back(residual.targets[a]);
+                }
+            }
+        }
+        if (level[sink] == none)  {
+            break;
+        }
+        std::copy(residual.offsets.begin(), residual.offsets.end() - 1, current.begin());
+        path.clear();
+        Vertex v = source;
+        while (true)  {
+            if (v == sink)  {
+                Capacity amount = residual.capacity[path[0]];
+                for (size_t a : path)  {
+                    amount = std::min(amount, residual.capacity[a]);
+                }
+                for (size_t a : path)  {
+                    residual.capacity[a] -= amount;
+                    residual.capacity[residual.reverse[a]] += amount;
+                }
+                value += amount;
+                // Откат к началу первой насыщенной дуги.
+                size_t saturated = 0;
+                while (residual.capacity[path[saturated]] > 0)  {
+                    ++saturated;
+                }
+                path.resize(saturated);
+                v = saturated == 0 ? source : residual.targets[path.back()];
+                continue;
+            }
+            size_t& a = current[v];
+            while (a < residual.offsets[v + 1] &&
+                   (residual.capacity[a] <= 0 || level[residual.targets[a]] != level[v] + 1))  {
+                ++a;
+            }
+            if (a < residual.offsets[v + 1])  {
+                path.push_back(a);
+                v = residual.targets[a];
+                continue;
+            }
+            // Тупик: вершина больше не нужна в этой фазе, возврат на шаг назад.
+            if (path.empty())  {
+                break;
+            }
+            level[v] = none;
+            path.pop_back();
+            v = path.empty() ? source : residual.targets[path.back()];
+            ++current[v];
+        }
+    }
+    return CollectFlow(graph, residual, source, value);
+}
+
+/**
+ * Максимальный поток: для невзвешенного графа (все пропускные способности равны 1) - алгоритм Диница,
+ * иначе - проталкивание предпотока.
+ * @param graph граф в представлении CSR.
+ * @param source исток.
+ * @param sink сток.
+ * @return максимальный поток и минимальный разрез.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+FlowResult<CapacityType<Weight>> MaxFlow(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex source, Vertex sink)  {
+    if constexpr (std::is_void_v<Weight>)  {
+        return Dinic(graph, source, sink);
+    }  else  {
+        return PushRelabel(graph, source, sink);
+    }
+}
+
+#endif //GRAPHS_MAXFLOW_H
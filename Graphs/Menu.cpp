@@ -1,6 +1,7 @@
 #include "Menu.h"
 #include "Reader.h"
 #include "Graph.h"
+#include "AsyncWriter.h"
 #include <iostream>
 #include <fstream>
 
@@ -83,6 +84,10 @@ void GetAction(int& action, int& mode)  {
         cout << "Actions with graph:\n1) Vertices degree\n2) Total number of edges/arcs\n"
                 "3) Convert and output graph <1/2/3/4>\n4) Recursive DFS <start_point>\n"
                 "5) Non-recursive DFS <start_point>\n6) Recursive BFS <start_point>\n"
+                "7) Shortest paths <start_point>\n8) Distances between all pairs of vertices\n"
+                "9) Reachability matrix\n10) Triangles and clustering coefficients\n"
+                "11) PageRank\n12) Topological order\n"
+                "13) Minimum spanning forest\n14) Bipartite matching\n15) K-core decomposition\n"
                 "Where:\n1 - Adjacency matrix\n2 - Incidence matrix\n"
                 "3 - Adjacency list\n4 - Edge list\n";
         cin >> input;
@@ -92,7 +97,7 @@ void GetAction(int& action, int& mode)  {
             cout << "Error: invalid number, try again!\n";
             continue;
         }
-        if (action == 3 || (3 < action && action < 7))  {
+        if (action == 3 || (3 < action && action < 8))  {
             cin >> input;
             try  {
                 mode = stoi(input);
@@ -101,16 +106,15 @@ void GetAction(int& action, int& mode)  {
                 continue;
             }
         }
-    } while (action < 1 || 6 < action || (action == 3 && (mode < 1 || 4 < mode)));
+    } while (action < 1 || 15 < action || (action == 3 && (mode < 1 || 4 < mode)));
 }
 
 /**
  * Распределяющая функция, вызывает функции класса Graph, для выполнения соответствующих действий.
  * @param writeMode куда будет записываться информация: консоль/файл.
- * @param oriented ориентированность графа.
  * @param fileStream поток, в который будет писаться информация.
  */
-void Action(int& writeMode, bool& oriented, ostream& fileStream)  {
+void Action(int& writeMode, ostream& fileStream)  {
     string loop;
     int action, mode = 0;
     do  {
@@ -118,16 +122,16 @@ void Action(int& writeMode, bool& oriented, ostream& fileStream)  {
         switch (action) {
             case 1:
                 if (writeMode == 1)  {
-                    Graph::VerticesDegree(oriented, std::cout);
+                    Graph::VerticesDegree(std::cout);
                 }  else  {
-                    Graph::VerticesDegree(oriented, fileStream);
+                    Graph::VerticesDegree(fileStream);
                 }
                 break;
             case 2:
                 if (writeMode == 1)  {
-                    Graph::CountArcEdges(oriented, std::cout);
+                    Graph::CountArcEdges(std::cout);
                 }  else  {
-                    Graph::CountArcEdges(oriented, fileStream);
+                    Graph::CountArcEdges(fileStream);
                 }
                 break;
             case 3:
@@ -144,6 +148,69 @@ void Action(int& writeMode, bool& oriented, ostream& fileStream)  {
                     Graph::GraphSearch(mode, action, fileStream);
                 }
                 break;
+            case 7:
+                if (writeMode == 1)  {
+                    Graph::Distances(mode, std::cout);
+                }  else  {
+                    Graph::Distances(mode, fileStream);
+                }
+                break;
+            case 8:
+                if (writeMode == 1)  {
+                    Graph::AllDistances(std::cout);
+                }  else  {
+                    Graph::AllDistances(fileStream);
+                }
+                break;
+            case 9:
+                if (writeMode == 1)  {
+                    Graph::PrintClosure(std::cout);
+                }  else  {
+                    Graph::PrintClosure(fileStream);
+                }
+                break;
+            case 10:
+                if (writeMode == 1)  {
+                    Graph::PrintTriangles(std::cout);
+                }  else  {
+                    Graph::PrintTriangles(fileStream);
+                }
+                break;
+            case 11:
+                if (writeMode == 1)  {
+                    Graph::PrintPageRank(std::cout);
+                }  else  {
+                    Graph::PrintPageRank(fileStream);
+                }
+                break;
+            case 12:
+                if (writeMode == 1)  {
+                    Graph::PrintTopologicalOrder(std::cout);
+                }  else  {
+                    Graph::PrintTopologicalOrder(fileStream);
+                }
+                break;
+            case 13:
+                if (writeMode == 1)  {
+                    Graph::PrintSpanningForest(std::cout);
+                }  else  {
+                    Graph::PrintSpanningForest(fileStream);
+                }
+                break;
+            case 14:
+                if (writeMode == 1)  {
+                    Graph::PrintMatching(std::cout);
+                }  else  {
+                    Graph::PrintMatching(fileStream);
+                }
+                break;
+            case 15:
+                if (writeMode == 1)  {
+                    Graph::PrintCores(std::cout);
+                }  else  {
+                    Graph::PrintCores(fileStream);
+                }
+                break;
             default:
                 break;
         }
@@ -157,7 +224,10 @@ void Action(int& writeMode, bool& oriented, ostream& fileStream)  {
 void Menu()  {
     int readWriteMode, graphMode;
     bool oriented;
-    std::ofstream fileStream("output.txt");
+    std::ofstream file("output.txt");
+    // Запись в файл идет в фоновом потоке, чтобы вычисления не ждали диска.
+    AsyncWriter fileWriter(file);
+    std::ostream fileStream(&fileWriter);
     string loop;
     do  {
         OrientedMode(oriented);
@@ -168,7 +238,7 @@ void Menu()  {
             continue;
         }
         ReadWriteMode(readWriteMode);
-        Action(readWriteMode, oriented, fileStream);
+        Action(readWriteMode, fileStream);
         Loop(loop);
     }  while (loop != "n");
 }
\ No newline at end of file
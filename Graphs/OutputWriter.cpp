@@ -0,0 +1,87 @@
+#include <cerrno>
+#include <unistd.h>
+#include "OutputWriter.h"
+
+/**
+ * Конструктор для вывода в поток.
+ * @param stream поток, в который будет сбрасываться буфер.
+ */
+OutputWriter::OutputWriter(std::ostream& stream) : mBuffer(new char[kBufferSize]), mStream(&stream)  {}
+
+/**
+ * Конструктор для вывода напрямую в файловый дескриптор.
+ * @param fd файловый дескриптор, в который будет сбрасываться буфер.
+ */
+OutputWriter::OutputWriter(int fd) : mBuffer(new char[kBufferSize]), mFd(fd)  {}
+
+/**
+ * Деструктор сбрасывает все, что осталось в буфере.
+ */
+OutputWriter::~OutputWriter()  {
+    Flush();
+}
+
+/**
+ * Вывод символа.
+ * @param symbol символ.
+ * @return ссылка на себя для цепочек вывода.
+ */
+OutputWriter& OutputWriter::operator<<(char symbol)  {
+    if (mSize == kBufferSize)  {
+        Flush();
+    }
+    mBuffer[mSize++] = symbol;
+    return *this;
+}
+
+/**
+ * Вывод строки. Строки длиннее буфера записываются сразу, минуя буфер.
+ * @param text строка.
+ * @return ссылка на себя для цепочек вывода.
+ */
+OutputWriter& OutputWriter::operator<<(std::string_view text)  {
+    if (mSize + text.size() > kBufferSize)  {
+        Flush();
+        if (text.size() > kBufferSize)  {
+            WriteBlock(text.data(), text.size());
+            return *this;
+        }
+    }
+    std::memcpy(mBuffer.get() + mSize, text.data(), text.size());
+    mSize += text.size();
+    return *this;
+}
+
+/**
+ * Сброс буфера.
+ */
+void OutputWriter::Flush()  {
+    if (mSize != 0)  {
+        WriteBlock(mBuffer.get(), mSize);
+        mSize = 0;
+    }
+}
+
+/**
+ * Запись блока данных в поток или дескриптор. При записи в дескриптор write может записать только часть данных
+ * или быть прерван сигналом, поэтому запись повторяется до конца блока.
+ * @param data данные.
+ * @param size размер данных.
+ */
+void OutputWriter::WriteBlock(const char* data, size_t size)  {
+    if (mStream != nullptr)  {
+        mStream->write(data, static_cast<std::streamsize>(size));
+        return;
+    }
+    while (size != 0)  {
+        ssize_t written = ::write(mFd, data, size);
+        if (written < 0)  {
+            if (errno == EINTR)  {
+                continue;
+            }
+            return;
+        }
+        data += written;
+        size -= size_t(written);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef GRAPHS_OUTPUTWRITER_H
+#define GRAPHS_OUTPUTWRITER_H
+
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+/**
+ * Буферизированный вывод: числа форматируются через std::to_chars прямо в большой буфер,
+ * который сбрасывается целиком либо в поток, либо напрямую в файловый дескриптор системным вызовом write.
+ * Буфер сбрасывается при заполнении, при вызове Flush и в деструкторе.
+ */
+class OutputWriter  {
+public:
+    // Размер буфера.
+    static constexpr size_t kBufferSize = 1 << 16;
+    // Вывод в поток.
+    explicit OutputWriter(std::ostream& stream);
+    // Вывод напрямую в файловый дескриптор.
+    explicit OutputWriter(int fd);
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+    ~OutputWriter();
+    // Вывод целого числа или числа с плавающей точкой.
+    template<typename T>
+    requires (std::integral<T> || std::floating_point<T>) && (!std::same_as<T, char>) && (!std::same_as<T, bool>)
+    OutputWriter& operator<<(T value);
+    // Вывод символа.
+    OutputWriter& operator<<(char symbol);
+    // Вывод строки.
+    OutputWriter& operator<<(std::string_view text);
+    // Сброс буфера.
+    void Flush();
+private:
+    // Запись готового блока данных.
+    void WriteBlock(const char* data, size_t size);
+    // Текущее заполнение буфера.
+    size_t mSize = 0;
+    // Буфер.
+    std::unique_ptr<char[]> mBuffer;
+    // Поток для вывода, либо nullptr при выводе в дескриптор.
+    std::ostream* mStream = nullptr;
+    // Файловый дескриптор для вывода.
+    int mFd = -1;
+};
+
+/**
+ * Вывод числа: std::to_chars пишет его прямо в буфер, без локалей и промежуточных строк.
+ * @param value число.
+ * @return ссылка на себя для цепочек вывода.
+ */
+template<typename T>
+requires (std::integral<T> || std::floating_point<T>) && (!std::same_as<T, char>) && (!std::same_as<T, bool>)
+OutputWriter& OutputWriter::operator<<(T value)  {
+    // Этого места хватает для любого целого числа и кратчайшего представления double.
+    constexpr size_t maxLength = 32;
+    if (mSize + maxLength > kBufferSize)  {
+        Flush();
+    }
+    auto result = std::to_chars(mBuffer.get() + mSize, mBuffer.get() + kBufferSize, value);
+    mSize = result.ptr - mBuffer.get();
+    return *this;
+}
+
+#endif //GRAPHS_OUTPUTWRITER_H
@@ -0,0 +1,122 @@
+#ifndef GRAPHS_PAGERANK_H
+#define GRAPHS_PAGERANK_H
+
+#include <vector>
+#include <span>
+#include <cmath>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+/**
+ * Умножение транспонированной матрицы смежности на вектор: y[v] - сумма x[u] по всем дугам (u, v).
+ * Каждая вершина собирает значения по входящим дугам сама (pull), поэтому потоки пишут только в свои элементы
+ * y и атомарные операции не нужны. Веса дуг не учитываются. Для орграфа нужны входящие дуги (BuildIncoming).
+ * @param graph граф в представлении CSR.
+ * @param x вектор значений вершин.
+ * @param y результат, размер - количество вершин.
+ */
+template<typename Real, typename Vertex, typename Weight, bool Directed>
+void SpMV(const CsrGraph<Vertex, Weight, Directed>& graph, std::span<const Real> x, std::span<Real> y)  {
+    Parallel::For(graph.Verts(), [&](size_t begin, size_t end, size_t)  {
+        for (size_t v = begin; v < end; ++v)  {
+            Real sum = 0;
+            for (Vertex u : graph.InNeighbors(Vertex(v)))  {
+                sum += x[u];
+            }
+            y[v] = sum;
+        }
+    });
+}
+
+/**
+ * Параметры PageRank.
+ */
+template<typename Real>
+struct PageRankOptions  {
+    // Вероятность перехода по дуге, с вероятностью 1 - damping переход в случайную вершину.
+    Real damping = Real(0.85);
+    // Итерации прекращаются, когда сумма модулей изменений рангов меньше tolerance.
+    Real tolerance = Real(1e-6);
+    // Наибольшее количество итераций.
+    size_t maxIterations = 100;
+};
+
+/**
+ * Результат PageRank.
+ */
+template<typename Real>
+struct PageRankResult  {
+    // Ранги вершин, в сумме 1.
+    std::vector<Real> ranks;
+    // Выполненное количество итераций.
+    size_t iterations = 0;
+    // Сумма модулей изменений рангов на последней итерации.
+    double error = 0;
+    // Достигнута ли точность за отведенные итерации.
+    bool converged = false;
+};
+
+/**
+ * PageRank степенным методом. На каждой итерации вклад вершины (ранг, деленный на полустепень исхода)
+ * собирается по входящим дугам через SpMV. Ранг висячих вершин (без исходящих дуг) распределяется поровну
+ * между всеми вершинами. Вершины обрабатываются параллельно блоками, суммы по блокам складываются по порядку,
+ * поэтому результат не зависит от количества потоков.
+ * @tparam Real тип ранга, float или double.
+ * @param graph граф в представлении CSR.
+ * @param options параметры.
+ * @return ранги вершин и сведения о сходимости.
+ */
+template<typename Real = double, typename Vertex, typename Weight, bool Directed>
+PageRankResult<Real> PageRank(const CsrGraph<Vertex, Weight, Directed>& graph,
+                              const PageRankOptions<Real>& options = {})  {
+    size_t verts = graph.Verts();
+    PageRankResult<Real> result;
+    if (verts == 0)  {
+        result.converged = true;
+        return result;
+    }
+    result.ranks.assign(verts, Real(1) / Real(verts));
+    std::vector<Real> contribution(verts), gathered(verts);
+    std::vector<double> blockSum(Parallel::ThreadCount(verts));
+    // Сумма значений по блокам, вычисляемых func(begin, end).
+    auto reduce = [&](const auto& func)  {
+        std::fill(blockSum.begin(), blockSum.end(), 0.0);
+        Parallel::For(verts, [&](size_t begin, size_t end, size_t block)  {
+            blockSum[block] = func(begin, end);
+        });
+        double sum = 0;
+        for (double value : blockSum)  {
+            sum += value;
+        }
+        return sum;
+    };
+    while (result.iterations < options.maxIterations && !result.converged)  {
+        double dangling = reduce([&](size_t begin, size_t end)  {
+            double sum = 0;
+            for (size_t v = begin; v < end; ++v)  {
+                size_t degree = graph.Degree(Vertex(v));
+                contribution[v] = degree == 0 ? Real(0) : result.ranks[v] / Real(degree);
+                if (degree == 0)  {
+                    sum += result.ranks[v];
+                }
+            }
+            return sum;
+        });
+        SpMV<Real>(graph, contribution, gathered);
+        Real base = Real((1 - options.damping + options.damping * dangling) / double(verts));
+        result.error = reduce([&](size_t begin, size_t end)  {
+            double sum = 0;
+            for (size_t v = begin; v < end; ++v)  {
+                Real rank = base + options.damping * gathered[v];
+                sum += std::abs(double(rank - result.ranks[v]));
+                result.ranks[v] = rank;
+            }
+            return sum;
+        });
+        ++result.iterations;
+        result.converged = result.error < options.tolerance;
+    }
+    return result;
+}
+
+#endif //GRAPHS_PAGERANK_H
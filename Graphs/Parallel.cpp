@@ -0,0 +1,20 @@
+#include <algorithm>
+#include "Parallel.h"
+
+/**
+ * Функция определяет, на сколько потоков имеет смысл разбить цикл.
+ * @param count количество итераций цикла.
+ * @return количество потоков, не меньшее 1.
+ */
+size_t Parallel::ThreadCount(size_t count)  {
+    size_t threads = sThreads;
+    if (threads == 0)  {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t grain = std::max<size_t>(1, sGrain);
+    threads = std::max<size_t>(1, std::min(threads, (count + grain - 1) / grain));
+    // Блоки имеют длину ceil(count / threads), поэтому их может понадобиться меньше, чем потоков: для count = 5
+    // и 4 потоков блоки по 2 итерации покрывают отрезок за 3 блока, а четвертый оказался бы пустым.
+    size_t chunk = (count + threads - 1) / threads;
+    return chunk == 0 ? 1 : (count + chunk - 1) / chunk;
+}
@@ -0,0 +1,52 @@
+#ifndef GRAPHS_PARALLEL_H
+#define GRAPHS_PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * Класс с настройками многопоточности и функцией для параллельного выполнения циклов.
+ */
+class Parallel  {
+public:
+    // Количество потоков, используемое параллельными функциями. 0 - по числу ядер процессора.
+    inline static size_t sThreads = 0;
+    // Минимальное количество итераций цикла, которое имеет смысл отдавать одному потоку.
+    inline static size_t sGrain = 64;
+    // Количество потоков, которое будет использовано для цикла из count итераций.
+    static size_t ThreadCount(size_t count);
+    // Параллельное выполнение цикла из count итераций, разбитого на непрерывные блоки.
+    template<typename Func>
+    static void For(size_t count, const Func& func);
+};
+
+/**
+ * Функция разбивает отрезок [0, count) на непрерывные блоки равной длины и выполняет каждый блок в своем потоке.
+ * Разбиение зависит только от count и количества потоков, поэтому если каждый блок пишет только в свою часть
+ * результата, то результат не зависит от порядка выполнения потоков.
+ * @param count количество итераций цикла.
+ * @param func функция вида func(begin, end, block), обрабатывающая итерации [begin, end).
+ */
+template<typename Func>
+void Parallel::For(size_t count, const Func& func)  {
+    size_t threads = ThreadCount(count);
+    if (threads <= 1)  {
+        func(size_t(0), count, size_t(0));
+        return;
+    }
+    std::vector<std::jthread> workers;
+    workers.reserve(threads - 1);
+    size_t chunk = (count + threads - 1) / threads;
+    for (size_t block = 1; block < threads; ++block)  {
+        size_t begin = block * chunk, end = std::min(count, begin + chunk);
+        workers.emplace_back([&func, begin, end, block]  {
+            func(begin, end, block);
+        });
+    }
+    // Первый блок выполняется в вызывающем потоке.
+    func(size_t(0), std::min(count, chunk), size_t(0));
+}
+
+#endif //GRAPHS_PARALLEL_H
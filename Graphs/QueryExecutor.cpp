@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <latch>
+#include "QueryExecutor.h"
+#include "Traversal.h"
+
+/**
+ * Конструктор исполнителя.
+ * @param graph неизменяемый снимок графа.
+ * @param threads количество потоков, 0 - по числу ядер процессора.
+ */
+QueryExecutor::QueryExecutor(Snapshot graph, size_t threads) : mGraph(std::move(graph)), mPool(threads)  {}
+
+/**
+ * Выполнение одного запроса. Функция только читает граф, поэтому может вызываться из многих потоков сразу.
+ * @param graph граф в представлении CSR.
+ * @param query запрос.
+ * @return для Degree - полустепени захода и исхода, для обходов - порядок вершин, для Path - вершины пути
+ * (пустой вектор, если пути нет).
+ */
+std::vector<uint32_t> QueryExecutor::Execute(const CsrGraph<>& graph, const GraphQuery& query)  {
+    switch (query.kind)  {
+        case QueryKind::Degree:
+            return {uint32_t(graph.InDegree(query.from)), uint32_t(graph.Degree(query.from))};
+        case QueryKind::Bfs:
+            return BfsTraversal(graph, query.from);
+        case QueryKind::Dfs:
+            return DfsTraversal(graph, query.from);
+        case QueryKind::Path:
+            return ShortestPath(graph, query.from, query.to);
+    }
+    return {};
+}
+
+/**
+ * Параллельное выполнение набора запросов. Запросы разбиваются на небольшие пачки, чтобы накладные расходы
+ * на задачи не превышали стоимость дешевых запросов, а перехват работы выравнивал нагрузку от дорогих.
+ * @param queries запросы.
+ * @return результаты в порядке запросов.
+ */
+std::vector<std::vector<uint32_t>> QueryExecutor::RunAll(const std::vector<GraphQuery>& queries)  {
+    std::vector<std::vector<uint32_t>> results(queries.size());
+    size_t chunk = std::max<size_t>(1, queries.size() / (mPool.Size() * 8));
+    size_t chunks = (queries.size() + chunk - 1) / chunk;
+    std::latch done(static_cast<std::ptrdiff_t>(chunks));
+    for (size_t begin = 0; begin < queries.size(); begin += chunk)  {
+        size_t end = std::min(queries.size(), begin + chunk);
+        mPool.Submit([this, &queries, &results, &done, begin, end]  {
+            for (size_t i = begin; i < end; ++i)  {
+                results[i] = Execute(*mGraph, queries[i]);
+            }
+            done.count_down();
+        });
+    }
+    done.wait();
+    return results;
+}
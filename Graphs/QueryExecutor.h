@@ -0,0 +1,55 @@
+#ifndef GRAPHS_QUERYEXECUTOR_H
+#define GRAPHS_QUERYEXECUTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+
+/**
+ * Виды запросов к графу, которые только читают его.
+ */
+enum class QueryKind  {
+    // Полустепени захода и исхода вершины.
+    Degree,
+    // Порядок обхода в ширину.
+    Bfs,
+    // Порядок обхода в глубину.
+    Dfs,
+    // Кратчайший по количеству дуг путь.
+    Path
+};
+
+/**
+ * Запрос к графу, вершины нумеруются с 0.
+ */
+struct GraphQuery  {
+    QueryKind kind = QueryKind::Degree;
+    uint32_t from = 0;
+    uint32_t to = 0;
+};
+
+/**
+ * Параллельное выполнение запросов над неизменяемым снимком графа.
+ * Снимок разделяется всеми потоками без блокировок, т.к. никто его не изменяет, а каждый запрос
+ * заводит собственные рабочие массивы. Запросы выполняются пулом потоков с перехватом работы.
+ */
+class QueryExecutor  {
+public:
+    // Неизменяемый снимок графа.
+    using Snapshot = std::shared_ptr<const CsrGraph<>>;
+    // Исполнитель над снимком, 0 потоков - по числу ядер процессора.
+    explicit QueryExecutor(Snapshot graph, size_t threads = 0);
+    // Выполнение одного запроса в вызывающем потоке.
+    static std::vector<uint32_t> Execute(const CsrGraph<>& graph, const GraphQuery& query);
+    // Параллельное выполнение набора запросов, результаты - в порядке запросов.
+    std::vector<std::vector<uint32_t>> RunAll(const std::vector<GraphQuery>& queries);
+private:
+    // Снимок графа.
+    Snapshot mGraph;
+    // Пул потоков.
+    ThreadPool mPool;
+};
+
+#endif //GRAPHS_QUERYEXECUTOR_H
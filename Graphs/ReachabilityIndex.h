@@ -0,0 +1,180 @@
+#ifndef GRAPHS_REACHABILITYINDEX_H
+#define GRAPHS_REACHABILITYINDEX_H
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_set>
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+#include "Condensation.h"
+
+/**
+ * Компактный индекс достижимости в духе GRAIL. Граф сжимается в конденсацию, по ней выполняется k обходов
+ * в глубину со случайным порядком вершин, и каждой компоненте в каждом обходе ставится интервал
+ * [наименьший номер в порядке выхода среди потомков, ее номер в порядке выхода]. Если из u достижима v,
+ * то интервал v лежит внутри интервала u во всех обходах, поэтому большинство отрицательных ответов
+ * получается сравнением k интервалов. Иначе выполняется обход из u, в котором отсекаются компоненты,
+ * интервалы или уровни которых не содержат v. Памяти нужно O(V + k * C), где C - количество компонент.
+ * Как и ReachabilityMatrix, вершина достигает себя, только если лежит на цикле.
+ */
+class ReachabilityIndex  {
+public:
+    /**
+     * Построение индекса, обходы выполняются параллельно.
+     * @param graph граф в представлении CSR.
+     * @param labels количество обходов (интервалов на компоненту).
+     * @param seed начальное значение генератора случайных чисел.
+     * @return индекс достижимости.
+     */
+    template<typename Vertex, typename Weight, bool Directed>
+    static ReachabilityIndex Build(const CsrGraph<Vertex, Weight, Directed>& graph, size_t labels = 3,
+                                   uint64_t seed = 1);
+
+    /**
+     * Проверка достижимости.
+     * @param from начало пути.
+     * @param to конец пути.
+     * @return true, если из from в to есть путь хотя бы из одной дуги.
+     */
+    [[nodiscard]] bool Reaches(size_t from, size_t to) const  {
+        uint32_t source = mComponent[from], target = mComponent[to];
+        if (source == target)  {
+            return mCyclic[source];
+        }
+        if (!MayReach(source, target))  {
+            return false;
+        }
+        // Обход конденсации из source с отсечением по интервалам.
+        std::vector<uint32_t> stack = {source};
+        std::unordered_set<uint32_t> visited = {source};
+        while (!stack.empty())  {
+            uint32_t c = stack.back();
+            stack.pop_back();
+            for (uint32_t d : mDag.Neighbors(c))  {
+                if (d == target)  {
+                    return true;
+                }
+                if (MayReach(d, target) && visited.insert(d).second)  {
+                    stack.push_back(d);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Количество вершин.
+    [[nodiscard]] size_t Verts() const  {
+        return mComponent.size();
+    }
+
+private:
+    // Необходимое условие достижимости target из c: уровень c больше и все интервалы c содержат интервалы target.
+    [[nodiscard]] bool MayReach(uint32_t c, uint32_t target) const  {
+        if (mLevel[c] <= mLevel[target])  {
+            return false;
+        }
+        for (size_t i = 0; i < mLabels; ++i)  {
+            if (mLow[c * mLabels + i] > mLow[target * mLabels + i] || mPost[c * mLabels + i] < mPost[target * mLabels + i])  {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Интервалы одного обхода со случайным порядком корней и дуг.
+    void Label(size_t label, uint64_t seed);
+
+    // Компонента каждой вершины.
+    std::vector<uint32_t> mComponent;
+    // Есть ли в компоненте цикл.
+    std::vector<char> mCyclic;
+    // Длина самого длинного пути из компоненты в конденсации.
+    std::vector<uint32_t> mLevel;
+    // Конденсация.
+    CsrGraph<uint32_t> mDag;
+    // Количество интервалов на компоненту.
+    size_t mLabels = 0;
+    // Границы интервалов, mLow[c * mLabels + i] и mPost[c * mLabels + i] для обхода i.
+    std::vector<uint32_t> mLow;
+    std::vector<uint32_t> mPost;
+};
+
+template<typename Vertex, typename Weight, bool Directed>
+ReachabilityIndex ReachabilityIndex::Build(const CsrGraph<Vertex, Weight, Directed>& graph, size_t labels,
+                                           uint64_t seed)  {
+    auto condensation = Condense(graph);
+    size_t count = condensation.Count();
+    ReachabilityIndex index;
+    index.mComponent.assign(condensation.component.begin(), condensation.component.end());
+    index.mCyclic = std::move(condensation.cyclic);
+    index.mDag.offsets = std::move(condensation.dag.offsets);
+    index.mDag.targets.assign(condensation.dag.targets.begin(), condensation.dag.targets.end());
+    // Дуги конденсации идут в компоненты с меньшими номерами, поэтому уровни считаются одним проходом.
+    index.mLevel.assign(count, 0);
+    for (uint32_t c = 0; c < count; ++c)  {
+        for (uint32_t d : index.mDag.Neighbors(c))  {
+            index.mLevel[c] = std::max(index.mLevel[c], index.mLevel[d] + 1);
+        }
+    }
+    index.mLabels = labels;
+    index.mLow.resize(count * labels);
+    index.mPost.resize(count * labels);
+    TaskGroup group;
+    for (size_t label = 0; label < labels; ++label)  {
+        group.Spawn([&index, label, seed]  {
+            index.Label(label, seed + label);
+        });
+    }
+    group.Wait();
+    return index;
+}
+
+/**
+ * Нерекурсивный обход конденсации в глубину. Корни и дуги каждой компоненты перебираются
+ * начиная со случайной позиции, чтобы разные обходы давали разные интервалы.
+ * @param label номер обхода.
+ * @param seed начальное значение генератора случайных чисел.
+ */
+inline void ReachabilityIndex::Label(size_t label, uint64_t seed)  {
+    size_t count = mCyclic.size();
+    std::mt19937_64 random(seed);
+    std::vector<uint32_t> roots(count), shift(count);
+    for (uint32_t c = 0; c < count; ++c)  {
+        roots[c] = c;
+        shift[c] = mDag.Degree(c) == 0 ? 0 : uint32_t(random() % mDag.Degree(c));
+    }
+    std::shuffle(roots.begin(), roots.end(), random);
+    std::vector<char> visited(count, 0);
+    // Стек пар (компонента, сколько дуг уже просмотрено).
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    uint32_t post = 0;
+    for (uint32_t root : roots)  {
+        if (visited[root])  {
+            continue;
+        }
+        visited[root] = 1;
+        stack.emplace_back(root, 0);
+        while (!stack.empty())  {
+            auto& [c, done] = stack.back();
+            size_t degree = mDag.Degree(c);
+            if (done < degree)  {
+                uint32_t d = mDag.targets[mDag.offsets[c] + (shift[c] + done++) % degree];
+                if (!visited[d])  {
+                    visited[d] = 1;
+                    stack.emplace_back(d, 0);
+                }
+                continue;
+            }
+            uint32_t low = post;
+            for (uint32_t d : mDag.Neighbors(c))  {
+                low = std::min(low, mLow[d * mLabels + label]);
+            }
+            mLow[c * mLabels + label] = low;
+            mPost[c * mLabels + label] = post++;
+            stack.pop_back();
+        }
+    }
+}
+
+#endif //GRAPHS_REACHABILITYINDEX_H
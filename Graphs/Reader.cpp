@@ -1,26 +1,32 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <map>
 #include <fstream>
 #include <filesystem>
 #include "Reader.h"
 #include "Graph.h"
+#include "EdgeIndex.h"
 
 using namespace std;
 
+// Наибольший вес дуги: сумма весов любого остовного леса или разреза помещается в 64 бита.
+constexpr long long kMaxWeight = 1000000000;
+
 /**
  * Функция для прочтения графа, задаваемого в виде матрицы смежности.
  * Все ограничения в этом методе описаны в README.txt.
  * @param verts количество вершин графа.
  * @param flag проверка, на то нужно ли читать информацию из файла.
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void ReadAdjacencyMatrix(size_t& verts, bool& flag, bool& oriented)  {
+void ReadAdjacencyMatrix(size_t& verts, bool& flag, bool& oriented, const string& path)  {
     string input; int value;
-    if(!std::filesystem::exists("input.txt") && flag)  {
+    if(!std::filesystem::exists(path) && flag)  {
         return;
     }
-    ifstream fin("input.txt");
+    ifstream fin(path);
     vector<vector<int>>matrix = vector<vector<int>>(verts, vector<int>(verts, 0));
     if (!flag)  {
         cout << "Enter the adjacency matrix:\n";
@@ -57,7 +63,7 @@ void ReadAdjacencyMatrix(size_t& verts, bool& flag, bool& oriented)  {
             --i;
         }
     }
-    new Graph(matrix, 1);
+    new Graph(matrix, 1, oriented);
 }
 
 /**
@@ -129,13 +135,14 @@ void RemoveInvalidEdges(vector<vector<int>>& matrix)  {
  * @param edges количество ребер/дуг графа.
  * @param flag проверка, на то нужно ли читать информацию из файла.
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void ReadIncidenceMatrix(size_t& verts, size_t& edges, bool& flag, bool& oriented)  {
+void ReadIncidenceMatrix(size_t& verts, size_t& edges, bool& flag, bool& oriented, const string& path)  {
     string input; int value;
-    if(!std::filesystem::exists("input.txt") && flag)  {
+    if(!std::filesystem::exists(path) && flag)  {
         return;
     }
-    ifstream fin("input.txt");
+    ifstream fin(path);
     vector<vector<int>>matrix = vector<vector<int>>(verts, vector<int>(edges, 0));
     if (!flag)  {
         cout << "Enter the incidence matrix:\n";
@@ -173,7 +180,7 @@ void ReadIncidenceMatrix(size_t& verts, size_t& edges, bool& flag, bool& oriente
         }
     }
     RemoveInvalidEdges(matrix);
-    new Graph(matrix, 2);
+    new Graph(matrix, 2, oriented);
 }
 
 /**
@@ -182,13 +189,14 @@ void ReadIncidenceMatrix(size_t& verts, size_t& edges, bool& flag, bool& oriente
  * @param verts количество вершин графа.
  * @param flag проверка, на то нужно ли читать информацию из файла.
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void ReadAdjacencyList(size_t& verts, bool& flag, bool& oriented)  {
+void ReadAdjacencyList(size_t& verts, bool& flag, bool& oriented, const string& path)  {
     string input; int value, edges;
-    if(!std::filesystem::exists("input.txt") && flag)  {
+    if(!std::filesystem::exists(path) && flag)  {
         return;
     }
-    ifstream fin("input.txt");
+    ifstream fin(path);
     vector<vector<int>>matrix = vector<vector<int>>(verts);
     // Необходимо добавление в множество и последующее копирование, для избегания дубликатов.
     vector<set<int>> filtered = vector<set<int>>(verts);
@@ -254,22 +262,24 @@ void ReadAdjacencyList(size_t& verts, bool& flag, bool& oriented)  {
             matrix[i].push_back(number);
         }
     }
-    new Graph(matrix, 3);
+    new Graph(matrix, 3, oriented);
 }
 
 /**
- * Функция для удаления идентичных дуг.
+ * Функция для удаления идентичных дуг. Встреченные дуги запоминаются в индексе,
+ * поэтому остается первое вхождение каждой дуги, а время работы линейно.
  * Все ограничения в этом методе описаны в README.txt.
  * @param matrix заданный граф.
  */
 void DeleteSimilarArcs(vector<vector<int>>& matrix)  {
+    EdgeIndex<uint32_t> seen(matrix.size());
+    size_t size = 0;
     for (size_t i = 0; i < matrix.size(); ++i)  {
-        for (size_t j = i + 1; j < matrix.size(); ++j)  {
-            if (matrix[i][0] == matrix[j][0] && matrix[i][1] == matrix[j][1])  {
-                matrix.erase(next(matrix.begin(), static_cast<int>(j)));
-            }
+        if (seen.Insert(uint32_t(matrix[i][0]), uint32_t(matrix[i][1])))  {
+            swap(matrix[size++], matrix[i]);
         }
     }
+    matrix.resize(size);
 }
 
 /**
@@ -292,13 +302,14 @@ void MakeMirrorArcs(vector<vector<int>>& matrix)  {
  * @param edges количество ребер/дуг графа.
  * @param flag проверка, на то нужно ли читать информацию из файла.
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void ReadEdgeList(size_t& verts, size_t& edges, bool& flag, bool& oriented)  {
+void ReadEdgeList(size_t& verts, size_t& edges, bool& flag, bool& oriented, const string& path)  {
     string input; int value;
-    if(!std::filesystem::exists("input.txt") && flag)  {
+    if(!std::filesystem::exists(path) && flag)  {
         return;
     }
-    ifstream fin("input.txt");
+    ifstream fin(path);
     vector<vector<int>>matrix = vector<vector<int>>(edges, vector<int>(2, 0));
     Graph::sVerts = verts;
     if (!flag)  {
@@ -342,7 +353,7 @@ void ReadEdgeList(size_t& verts, size_t& edges, bool& flag, bool& oriented)  {
         MakeMirrorArcs(matrix);
     }
     DeleteSimilarArcs(matrix);
-    new Graph(matrix, 4);
+    new Graph(matrix, 4, oriented);
 }
 
 
@@ -399,13 +410,14 @@ void GetSizeFromConsole(size_t& verts, size_t& edges, int& graphMode, bool& orie
  * @param edges количество ребер/дуг графа.
  * @param graphMode способ задания графа (матрица смежности и т.д.).
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void GetSizeFromFile(size_t& verts, size_t& edges, int& graphMode, bool& oriented)  {
+void GetSizeFromFile(size_t& verts, size_t& edges, int& graphMode, bool& oriented, const string& path)  {
     string input;
-    if(!std::filesystem::exists("input.txt"))  {
+    if(!std::filesystem::exists(path))  {
         return;
     }
-    ifstream fin("input.txt");
+    ifstream fin(path);
     fin >> input;
     try  {
         verts = stoi(input);
@@ -449,20 +461,21 @@ void GetSizeFromFile(size_t& verts, size_t& edges, int& graphMode, bool& oriente
  * @param graphMode способ задания графа (матрица смежности и т.д.).
  * @param flag проверка, на то нужно ли читать информацию из файла.
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void Read(size_t verts, size_t edges, int& graphMode, bool flag, bool& oriented)  {
+void Read(size_t verts, size_t edges, int& graphMode, bool flag, bool& oriented, const string& path)  {
     switch (graphMode) {
         case 1:
-            ReadAdjacencyMatrix(verts, flag, oriented);
+            ReadAdjacencyMatrix(verts, flag, oriented, path);
             break;
         case 2:
-            ReadIncidenceMatrix(verts, edges, flag, oriented);
+            ReadIncidenceMatrix(verts, edges, flag, oriented, path);
             break;
         case 3:
-            ReadAdjacencyList(verts, flag, oriented);
+            ReadAdjacencyList(verts, flag, oriented, path);
             break;
         case 4:
-            ReadEdgeList(verts, edges, flag, oriented);
+            ReadEdgeList(verts, edges, flag, oriented, path);
             break;
         default:
             break;
@@ -474,14 +487,56 @@ void Read(size_t verts, size_t edges, int& graphMode, bool flag, bool& oriented)
  * @param readMode способ чтения: из файла/ из консоли.
  * @param graphMode способ задания графа (матрица смежности и т.д.).
  * @param oriented ориентированность графа.
+ * @param path путь к файлу, из которого читается граф.
  */
-void ReadGraph(int readMode, int graphMode, bool oriented)  {
+void ReadGraph(int readMode, int graphMode, bool oriented, const string& path)  {
     size_t verts, edges;
     if (readMode == 1)  {
         GetSizeFromConsole(verts, edges, graphMode, oriented);
-        Read(verts, edges, graphMode, false, oriented);
+        Read(verts, edges, graphMode, false, oriented, path);
     }  else  {
-        GetSizeFromFile(verts, edges, graphMode, oriented);
-        Read(verts, edges, graphMode, true, oriented);
+        GetSizeFromFile(verts, edges, graphMode, oriented, path);
+        Read(verts, edges, graphMode, true, oriented, path);
+    }
+}
+/**
+ * Функция для прочтения весов дуг уже прочитанного графа. Файл состоит из троек: начало, конец и вес дуги,
+ * вес - целое число от 0 до 10^9. Дуги без заданного веса имеют вес 1, у неорграфа вес задается сразу
+ * обоим направлениям ребра. Все ограничения в этом методе описаны в README.txt.
+ * @param path путь к файлу, из которого читаются веса.
+ * @return true, если все веса корректны и заданы существующим дугам, иначе false.
+ */
+bool ReadWeights(const string& path)  {
+    ifstream fin(path);
+    if (!fin)  {
+        cerr << "Error: can't open " << path << "!\n";
+        return false;
+    }
+    auto graph = Graph::Snapshot();
+    auto arcs = EdgeIndex<uint32_t>::FromCsr(*graph);
+    map<pair<int, int>, int64_t> weights;
+    string from, to, weight;
+    for (size_t i = 1; fin >> from; ++i)  {
+        try  {
+            to.clear();
+            weight.clear();
+            fin >> to >> weight;
+            int u = stoi(from), v = stoi(to);
+            long long value = stoll(weight);
+            // Проверка, что дуга есть в графе, а вес лежит в нужном диапазоне.
+            if (u < 1 || graph->Verts() < size_t(u) || v < 1 || graph->Verts() < size_t(v) ||
+            !arcs.HasEdge(uint32_t(u - 1), uint32_t(v - 1)) || value < 0 || kMaxWeight < value)  {
+                throw invalid_argument("");
+            }
+            weights[{u, v}] = value;
+            if (!Graph::IsOriented())  {
+                weights[{v, u}] = value;
+            }
+        }  catch(exception&)  {
+            cerr << "Error: invalid weight #" << i << " in " << path << "!\n";
+            return false;
+        }
     }
-}
\ No newline at end of file
+    Graph::SetWeights(std::move(weights));
+    return true;
+}
@@ -1,5 +1,8 @@
 #ifndef GRAPHS_READER_H
 #define GRAPHS_READER_H
+#include <string>
 // Распределяющий метод для считывания графов.
-void ReadGraph(int readMode, int graphMode, bool oriented);
+void ReadGraph(int readMode, int graphMode, bool oriented, const std::string& path = "input.txt");
+// Чтение весов дуг уже прочитанного графа.
+bool ReadWeights(const std::string& path);
 #endif //GRAPHS_READER_H
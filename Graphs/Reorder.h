@@ -0,0 +1,224 @@
+#ifndef GRAPHS_REORDER_H
+#define GRAPHS_REORDER_H
+
+#include <vector>
+#include <cassert>
+#include <numeric>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+/**
+ * Перенумерация вершин графа. Хранит соответствие в обе стороны, чтобы результаты алгоритмов,
+ * посчитанные на перенумерованном графе, можно было выводить в исходных номерах.
+ * Пустая перенумерация - тождественная.
+ */
+template<typename Vertex>
+struct Permutation  {
+    // Исходный номер вершины по новому.
+    std::vector<Vertex> toOriginal;
+    // Новый номер вершины по исходному.
+    std::vector<Vertex> toNew;
+    // Новый номер вершины с исходным номером v.
+    [[nodiscard]] Vertex ToNew(Vertex v) const  {
+        return toNew.empty() ? v : toNew[v];
+    }
+    // Исходный номер вершины с новым номером v.
+    [[nodiscard]] Vertex ToOriginal(Vertex v) const  {
+        return toOriginal.empty() ? v : toOriginal[v];
+    }
+    // Построение перенумерации по порядку вершин: order[i] - исходный номер вершины, получающей номер i.
+    static Permutation FromOrder(std::vector<Vertex> order)  {
+        Permutation permutation;
+        permutation.toNew.resize(order.size());
+        for (size_t i = 0; i < order.size(); ++i)  {
+            permutation.toNew[order[i]] = Vertex(i);
+        }
+        permutation.toOriginal = std::move(order);
+        return permutation;
+    }
+};
+
+/**
+ * Суммарная степень вершины: для орграфа учитываются и входящие, и исходящие дуги.
+ * @param graph граф в представлении CSR.
+ * @param v вершина.
+ * @return степень вершины.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+size_t TotalDegree(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex v)  {
+    if constexpr (Directed)  {
+        return graph.Degree(v) + graph.InDegree(v);
+    }  else  {
+        return graph.Degree(v);
+    }
+}
+
+/**
+ * Перенумерация по убыванию степени: вершины с наибольшим числом соседей получают меньшие номера
+ * и оказываются рядом в памяти. При равных степенях сохраняется исходный порядок.
+ * @param graph граф в представлении CSR.
+ * @return перенумерация вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Permutation<Vertex> DegreeOrder(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    std::vector<Vertex> order(graph.Verts());
+    std::iota(order.begin(), order.end(), Vertex(0));
+    std::stable_sort(order.begin(), order.end(), [&graph](Vertex a, Vertex b)  {
+        return TotalDegree(graph, a) > TotalDegree(graph, b);
+    });
+    return Permutation<Vertex>::FromOrder(std::move(order));
+}
+
+/**
+ * Порядок обхода в ширину без учета направления дуг, начиная с вершины start.
+ * Остальные компоненты связности обходятся по мере возрастания номеров, соседи - в порядке,
+ * заданном функцией сравнения.
+ * @param graph граф в представлении CSR.
+ * @param start точка из которой начинаем обход.
+ * @param less функция сравнения для порядка обхода соседей.
+ * @return порядок вершин, в котором каждая вершина встречается ровно один раз.
+ */
+template<typename Vertex, typename Weight, bool Directed, typename Less>
+std::vector<Vertex> BreadthFirstOrder(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex start, Less less)  {
+    size_t verts = graph.Verts();
+    std::vector<Vertex> order;
+    order.reserve(verts);
+    std::vector<char> visited(verts, 0);
+    std::vector<Vertex> neighbors;
+    auto traverse = [&](Vertex source)  {
+        visited[source] = 1;
+        // Сама очередь - это конец массива order, начиная с позиции head.
+        size_t head = order.size();
+        order.push_back(source);
+        while (head < order.size())  {
+            Vertex v = order[head++];
+            neighbors.assign(graph.Neighbors(v).begin(), graph.Neighbors(v).end());
+            if constexpr (Directed)  {
+                neighbors.insert(neighbors.end(), graph.InNeighbors(v).begin(), graph.InNeighbors(v).end());
+            }
+            std::stable_sort(neighbors.begin(), neighbors.end(), less);
+            for (Vertex to : neighbors)  {
+                if (!visited[to])  {
+                    visited[to] = 1;
+                    order.push_back(to);
+                }
+            }
+        }
+    };
+    if (verts != 0)  {
+        traverse(start);
+    }
+    for (size_t root = 0; root < verts; ++root)  {
+        if (!visited[root])  {
+            traverse(Vertex(root));
+        }
+    }
+    return order;
+}
+
+/**
+ * Перенумерация в порядке обхода в ширину: соседи по обходу получают близкие номера.
+ * @param graph граф в представлении CSR.
+ * @param start точка из которой начинаем обход.
+ * @return перенумерация вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Permutation<Vertex> BfsOrder(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex start = 0)  {
+    std::vector<Vertex> order = BreadthFirstOrder(graph, start, std::less<Vertex>());
+    assert(order.size() == graph.Verts());
+    return Permutation<Vertex>::FromOrder(std::move(order));
+}
+
+/**
+ * Обратная перенумерация Катхилла-Макки: обход в ширину из вершины наименьшей степени,
+ * соседи обходятся по возрастанию степени, полученный порядок разворачивается.
+ * Уменьшает ширину ленты матрицы смежности, т.е. смежные вершины получают близкие номера.
+ * @param graph граф в представлении CSR.
+ * @return перенумерация вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Permutation<Vertex> ReverseCuthillMcKeeOrder(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    auto byDegree = [&graph](Vertex a, Vertex b)  {
+        return TotalDegree(graph, a) < TotalDegree(graph, b);
+    };
+    Vertex start = 0;
+    for (size_t v = 1; v < graph.Verts(); ++v)  {
+        if (byDegree(Vertex(v), start))  {
+            start = Vertex(v);
+        }
+    }
+    std::vector<Vertex> order = BreadthFirstOrder(graph, start, byDegree);
+    std::reverse(order.begin(), order.end());
+    assert(order.size() == graph.Verts());
+    return Permutation<Vertex>::FromOrder(std::move(order));
+}
+
+/**
+ * Перестроение графа под перенумерацию: вершина с новым номером v получает смежные вершины исходной вершины,
+ * переведенные в новые номера и отсортированные по возрастанию. Строки перестраиваются параллельно.
+ * @param graph граф в представлении CSR.
+ * @param permutation перенумерация вершин.
+ * @return перенумерованный граф.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+CsrGraph<Vertex, Weight, Directed> Relabel(const CsrGraph<Vertex, Weight, Directed>& graph,
+                                           const Permutation<Vertex>& permutation)  {
+    using Graph = CsrGraph<Vertex, Weight, Directed>;
+    size_t verts = graph.Verts();
+    Graph result;
+    result.offsets.assign(verts + 1, 0);
+    for (size_t v = 0; v < verts; ++v)  {
+        result.offsets[v + 1] = result.offsets[v] + graph.Degree(permutation.toOriginal[v]);
+    }
+    result.targets.resize(graph.Arcs());
+    if constexpr (Graph::kWeighted)  {
+        result.weights.resize(graph.Arcs());
+    }
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        std::vector<size_t> arcs;
+        for (size_t v = begin; v < end; ++v)  {
+            Vertex original = permutation.toOriginal[v];
+            arcs.resize(graph.Degree(original));
+            std::iota(arcs.begin(), arcs.end(), graph.offsets[original]);
+            std::sort(arcs.begin(), arcs.end(), [&](size_t a, size_t b)  {
+                return permutation.toNew[graph.targets[a]] < permutation.toNew[graph.targets[b]];
+            });
+            for (size_t i = 0; i < arcs.size(); ++i)  {
+                result.targets[result.offsets[v] + i] = permutation.toNew[graph.targets[arcs[i]]];
+                if constexpr (Graph::kWeighted)  {
+                    result.weights[result.offsets[v] + i] = graph.weights[arcs[i]];
+                }
+            }
+        }
+    });
+    result.BuildIncoming();
+    return result;
+}
+
+// Способ перенумерации вершин.
+enum class Reordering  {
+    None, Degree, Bfs, ReverseCuthillMcKee
+};
+
+/**
+ * Перенумерация выбранным способом.
+ * @param graph граф в представлении CSR.
+ * @param reordering способ перенумерации.
+ * @return перенумерация вершин, пустая для Reordering::None.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+Permutation<Vertex> MakePermutation(const CsrGraph<Vertex, Weight, Directed>& graph, Reordering reordering)  {
+    switch (reordering)  {
+        case Reordering::Degree:
+            return DegreeOrder(graph);
+        case Reordering::Bfs:
+            return BfsOrder(graph);
+        case Reordering::ReverseCuthillMcKee:
+            return ReverseCuthillMcKeeOrder(graph);
+        default:
+            return {};
+    }
+}
+
+#endif //GRAPHS_REORDER_H
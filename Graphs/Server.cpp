@@ -0,0 +1,444 @@
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "BatchQueries.h"
+#include "MaxFlow.h"
+#include "Server.h"
+#include "ThreadPool.h"
+
+// Наибольшая длина запроса: клиент, приславший больше без перевода строки, отключается.
+constexpr size_t kMaxRequest = 1 << 16;
+
+/**
+ * Конструктор сервера. Если задана перенумерация, сервер работает с перенумерованной копией снимка.
+ * @param graph снимок графа.
+ * @param oriented ориентированность графа.
+ * @param reordering способ перенумерации вершин.
+ * @param capacities пропускные способности дуг того же графа, nullptr - все дуги пропускают 1.
+ */
+Server::Server(QueryExecutor::Snapshot graph, bool oriented, Reordering reordering, Capacities capacities)
+        : mOrder(MakePermutation(*graph, reordering)),
+          mGraph(reordering == Reordering::None ? std::move(graph)
+                                                : std::make_shared<const CsrGraph<>>(Relabel(*graph, mOrder))),
+          mCapacities(!capacities || reordering == Reordering::None ? std::move(capacities)
+                      : std::make_shared<const CsrGraph<uint32_t, int64_t>>(Relabel(*capacities, mOrder))),
+          mOriented(oriented), mReachability(ReachabilityIndex::Build(*mGraph)),
+          mEdges(EdgeIndex<uint32_t>::FromCsr(*mGraph))  {}
+
+/**
+ * Номер вершины в снимке по исходному номеру.
+ * @param vertex исходный номер вершины с 1, уже проверенный.
+ * @return номер вершины в снимке с 0.
+ */
+uint32_t Server::ToSnapshot(size_t vertex) const  {
+    return mOrder.ToNew(uint32_t(vertex - 1));
+}
+
+/**
+ * Чтение следующего числа из запроса.
+ * @param request запрос, из начала которого число удаляется.
+ * @param value прочитанное число.
+ * @return true, если число прочитано, иначе false.
+ */
+bool NextNumber(std::string_view& request, size_t& value)  {
+    while (!request.empty() && request.front() == ' ')  {
+        request.remove_prefix(1);
+    }
+    auto result = std::from_chars(request.data(), request.data() + request.size(), value);
+    if (result.ec != std::errc() || result.ptr == request.data())  {
+        return false;
+    }
+    request.remove_prefix(result.ptr - request.data());
+    return true;
+}
+
+/**
+ * Вывод списка вершин в исходных номерах с 1.
+ * @param vertices вершины снимка.
+ * @param response вывод, в который пишется ответ.
+ */
+template<typename Range>
+void Server::WriteVertices(const Range& vertices, OutputWriter& response) const  {
+    for (auto v : vertices)  {
+        response << ' ' << (size_t(mOrder.ToOriginal(uint32_t(v))) + 1);
+    }
+}
+
+/**
+ * Ответ на один запрос. Вершины в запросе и ответе нумеруются с 1.
+ * @param request строка запроса без перевода строки.
+ * @param response вывод, в который пишется ответ.
+ */
+void Server::Answer(std::string_view request, OutputWriter& response)  {
+    static const std::pair<std::string_view, QueryKind> commands[] = {
+            {"degree", QueryKind::Degree}, {"bfs", QueryKind::Bfs},
+            {"dfs", QueryKind::Dfs}, {"path", QueryKind::Path}
+    };
+    std::string_view command = request.substr(0, request.find(' '));
+    request.remove_prefix(command.size());
+    if (command == "shutdown")  {
+        // Опрашивающий поток увидит признак, когда задача с этим запросом сообщит о завершении.
+        mStop = true;
+        response << "OK\n";
+        return;
+    }
+    if (command == "reaches")  {
+        size_t from, to;
+        if (!NextNumber(request, from) || !NextNumber(request, to))  {
+            response << "ERR invalid request\n";
+        }  else if (from < 1 || mGraph->Verts() < from || to < 1 || mGraph->Verts() < to)  {
+            response << "ERR invalid vertex\n";
+        }  else  {
+            response << "OK " << int(mReachability.Reaches(ToSnapshot(from), ToSnapshot(to))) << '\n';
+        }
+        return;
+    }
+    if (command == "flow")  {
+        size_t from, to;
+        if (!NextNumber(request, from) || !NextNumber(request, to))  {
+            response << "ERR invalid request\n";
+            return;
+        }
+        if (from < 1 || mGraph->Verts() < from || to < 1 || mGraph->Verts() < to)  {
+            response << "ERR invalid vertex\n";
+            return;
+        }
+        // С весами поток ищется проталкиванием предпотока, без весов - алгоритмом Диница.
+        auto write = [&](const auto& flow)  {
+            response << "OK " << flow.value;
+            for (size_t v = 0; v < mGraph->Verts(); ++v)  {
+                for (uint32_t u : mGraph->Neighbors(uint32_t(v)))  {
+                    if (flow.sourceSide[v] && !flow.sourceSide[u])  {
+                        WriteVertices(std::initializer_list<uint32_t>{uint32_t(v), u}, response);
+                    }
+                }
+            }
+            response << '\n';
+        };
+        if (mCapacities)  {
+            write(MaxFlow(*mCapacities, ToSnapshot(from), ToSnapshot(to)));
+        }  else  {
+            write(MaxFlow(*mGraph, ToSnapshot(from), ToSnapshot(to)));
+        }
+        return;
+    }
+    if (command == "degrees" || command == "neighbors" || command == "arcs")  {
+        AnswerBatch(command, request, response);
+        return;
+    }
+    GraphQuery query;
+    bool known = false;
+    for (auto& [name, kind] : commands)  {
+        if (command == name)  {
+            query.kind = kind;
+            known = true;
+        }
+    }
+    if (!known)  {
+        response << "ERR unknown command\n";
+        return;
+    }
+    size_t count = query.kind == QueryKind::Path ? 2 : 1, from = 0, to = 1;
+    if (!NextNumber(request, from) || (count > 1 && !NextNumber(request, to)))  {
+        response << "ERR invalid request\n";
+        return;
+    }
+    size_t verts = mGraph->Verts();
+    if (from < 1 || verts < from || to < 1 || verts < to)  {
+        response << "ERR invalid vertex\n";
+        return;
+    }
+    query.from = ToSnapshot(from);
+    query.to = ToSnapshot(to);
+    auto result = QueryExecutor::Execute(*mGraph, query);
+    switch (query.kind)  {
+        case QueryKind::Degree:
+            if (mOriented)  {
+                response << "OK " << result[0] << ' ' << result[1] << '\n';
+            }  else  {
+                response << "OK " << result[1] << '\n';
+            }
+            return;
+        case QueryKind::Path:
+            if (result.empty())  {
+                response << "NONE\n";
+                return;
+            }
+            response << "OK " << (result.size() - 1);
+            break;
+        default:
+            response << "OK";
+            break;
+    }
+    WriteVertices(result, response);
+    response << '\n';
+}
+
+/**
+ * Ответ на пакетный запрос: degrees <v1> <v2> ..., neighbors <v1> <v2> ... или arcs <u1> <v1> <u2> <v2> ...
+ * @param command команда.
+ * @param request номера вершин.
+ * @param response поток ответа.
+ */
+void Server::AnswerBatch(std::string_view command, std::string_view request, OutputWriter& response)  {
+    std::vector<uint32_t> vertices;
+    size_t value, verts = mGraph->Verts();
+    while (NextNumber(request, value))  {
+        if (value < 1 || verts < value)  {
+            response << "ERR invalid vertex\n";
+            return;
+        }
+        vertices.push_back(ToSnapshot(value));
+    }
+    bool pairs = command == "arcs";
+    if (vertices.empty() || (pairs && vertices.size() % 2 != 0))  {
+        response << "ERR invalid request\n";
+        return;
+    }
+    response << "OK";
+    if (pairs)  {
+        std::vector<std::pair<uint32_t, uint32_t>> arcs(vertices.size() / 2);
+        for (size_t i = 0; i < arcs.size(); ++i)  {
+            arcs[i] = {vertices[2 * i], vertices[2 * i + 1]};
+        }
+        for (char found : BatchHasArcs<uint32_t>(mEdges, arcs))  {
+            response << ' ' << int(found);
+        }
+    }  else if (command == "neighbors")  {
+        auto batch = BatchNeighbors<uint32_t>(*mGraph, vertices);
+        for (size_t i = 0; i < vertices.size(); ++i)  {
+            auto first = batch.neighbors.begin() + std::ptrdiff_t(batch.offsets[i]);
+            auto last = batch.neighbors.begin() + std::ptrdiff_t(batch.offsets[i + 1]);
+            response << ' ' << size_t(last - first);
+            WriteVertices(std::span<const uint32_t>(first, last), response);
+        }
+    }  else  {
+        for (size_t degree : BatchDegrees<uint32_t>(*mGraph, vertices))  {
+            response << ' ' << degree;
+        }
+    }
+    response << '\n';
+}
+
+/**
+ * Чтение данных, пришедших от клиента. Вызывается, только когда poll сообщил о данных, поэтому не блокируется.
+ * Клиент опрашивается, только пока у него нет полных запросов, поэтому копиться может лишь незаконченная строка;
+ * если она длиннее kMaxRequest, клиент получает ошибку и отключается.
+ * @param fd сокет клиента.
+ * @param client состояние клиента.
+ * @return false, если клиент закрыл соединение, прислал слишком длинный запрос или произошла ошибка, иначе true.
+ */
+bool Server::Receive(int fd, Client& client)  {
+    char buffer[kMaxRequest];
+    ssize_t size = ::read(fd, buffer, sizeof(buffer));
+    if (size < 0)  {
+        return errno == EINTR || errno == EAGAIN;
+    }
+    if (size == 0)  {
+        return false;
+    }
+    client.pending.append(buffer, size_t(size));
+    if (kMaxRequest < client.pending.size() && client.pending.find('\n') == std::string::npos)  {
+        OutputWriter response(fd);
+        response << "ERR request too long\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Передача пулу следующего полного запроса клиента. Задача отвечает на запрос, сама отправляет ответ
+ * и сообщает опрашивающему потоку, что клиент свободен.
+ * @param fd сокет клиента.
+ * @param client состояние клиента.
+ * @param pool пул потоков.
+ */
+void Server::Dispatch(int fd, Client& client, ThreadPool& pool)  {
+    size_t end = client.pending.find('\n');
+    if (client.busy || mStop || end == std::string::npos)  {
+        return;
+    }
+    std::string line = client.pending.substr(0, end);
+    client.pending.erase(0, end + 1);
+    if (!line.empty() && line.back() == '\r')  {
+        line.pop_back();
+    }
+    client.busy = true;
+    pool.Submit([this, fd, line = std::move(line)]  {
+        {
+            OutputWriter response(fd);
+            Answer(line, response);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDone.push_back(fd);
+        }
+        Wake();
+    });
+}
+
+/**
+ * Пробуждение опрашивающего потока. Канал неблокирующий: если он полон, поток и так проснется.
+ */
+void Server::Wake()  {
+    char signal = 0;
+    [[maybe_unused]] ssize_t written = ::write(mWakeup[1], &signal, 1);
+}
+
+/**
+ * Цикл опроса: принимает клиентов, читает их запросы и отдает пулу, пока не придет запрос shutdown.
+ * Сокеты клиентов, у которых выполняется запрос, не опрашиваются, пока задача не завершится.
+ * После shutdown новые запросы не выполняются, клиенты отключаются по мере завершения их запросов.
+ * @param pool пул потоков.
+ */
+void Server::Poll(ThreadPool& pool)  {
+    std::unordered_map<int, Client> clients;
+    std::vector<pollfd> fds;
+    auto disconnect = [&](int fd)  {
+        ::shutdown(fd, SHUT_RDWR);
+        ::close(fd);
+        clients.erase(fd);
+    };
+    while (true)  {
+        std::vector<int> done;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            done.swap(mDone);
+        }
+        for (int fd : done)  {
+            clients[fd].busy = false;
+            Dispatch(fd, clients[fd], pool);
+        }
+        if (mStop)  {
+            for (auto it = clients.begin(); it != clients.end();)  {
+                int fd = it->first;
+                bool busy = it->second.busy;
+                ++it;
+                if (!busy)  {
+                    disconnect(fd);
+                }
+            }
+            if (clients.empty())  {
+                return;
+            }
+        }
+        fds.assign(1, pollfd{mWakeup[0], POLLIN, 0});
+        if (!mStop)  {
+            fds.push_back(pollfd{mListener, POLLIN, 0});
+        }
+        for (auto& [fd, client] : clients)  {
+            if (!client.busy)  {
+                fds.push_back(pollfd{fd, POLLIN, 0});
+            }
+        }
+        if (::poll(fds.data(), fds.size(), -1) < 0)  {
+            if (errno == EINTR)  {
+                continue;
+            }
+            std::cerr << "Error: poll failed: " << std::strerror(errno) << "!\n";
+            mStop = true;
+            continue;
+        }
+        for (const pollfd& entry : fds)  {
+            if (entry.revents == 0)  {
+                continue;
+            }
+            if (entry.fd == mWakeup[0])  {
+                char buffer[64];
+                while (::read(mWakeup[0], buffer, sizeof(buffer)) > 0)  {}
+            }  else if (entry.fd == mListener)  {
+                int client = ::accept4(mListener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client >= 0)  {
+                    clients.emplace(client, Client());
+                }
+            }  else if (Receive(entry.fd, clients[entry.fd]))  {
+                Dispatch(entry.fd, clients[entry.fd], pool);
+            }  else  {
+                disconnect(entry.fd);
+            }
+        }
+    }
+}
+
+/**
+ * Удаление сокета, оставшегося от завершившегося сервера. Путь удаляется, только если это сокет и к нему
+ * нельзя подключиться (ECONNREFUSED), т.е. его никто не слушает. Обычный файл или сокет работающего
+ * сервера не трогаются.
+ * @param path путь к сокету.
+ * @param address адрес сокета.
+ * @return true, если путь свободен, иначе false (ошибка уже выведена).
+ */
+bool RemoveStaleSocket(const std::string& path, const sockaddr_un& address)  {
+    struct stat info{};
+    if (::lstat(path.c_str(), &info) < 0)  {
+        if (errno == ENOENT)  {
+            return true;
+        }
+        std::cerr << "Error: can't check " << path << ": " << std::strerror(errno) << "!\n";
+        return false;
+    }
+    if (!S_ISSOCK(info.st_mode))  {
+        std::cerr << "Error: " << path << " exists and is not a socket!\n";
+        return false;
+    }
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool refused = probe >= 0 && ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 &&
+                   errno == ECONNREFUSED;
+    if (probe >= 0)  {
+        ::close(probe);
+    }
+    if (!refused)  {
+        std::cerr << "Error: " << path << " is in use by another server!\n";
+        return false;
+    }
+    if (::unlink(path.c_str()) < 0)  {
+        std::cerr << "Error: can't remove " << path << ": " << std::strerror(errno) << "!\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Запуск сервера: создает сокет по пути path и обслуживает клиентов, пока не придет запрос shutdown.
+ * @param path путь к сокету.
+ * @param workers количество потоков, выполняющих запросы, 0 - по числу ядер процессора.
+ * @return код завершения программы.
+ */
+int Server::Run(const std::string& path, size_t workers)  {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))  {
+        std::cerr << "Error: socket path is too long!\n";
+        return 1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    // Клиент может закрыть соединение, не дождавшись ответа, сервер при этом не должен завершаться.
+    std::signal(SIGPIPE, SIG_IGN);
+    if (!RemoveStaleSocket(path, address))  {
+        return 1;
+    }
+    mListener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (mListener < 0 || ::bind(mListener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(mListener, SOMAXCONN) < 0 || ::pipe2(mWakeup, O_NONBLOCK | O_CLOEXEC) < 0)  {
+        std::cerr << "Error: can't listen on " << path << ": " << std::strerror(errno) << "!\n";
+        return 1;
+    }
+    {
+        ThreadPool pool(workers);
+        Poll(pool);
+    }
+    ::close(mListener);
+    ::close(mWakeup[0]);
+    ::close(mWakeup[1]);
+    ::unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,96 @@
+#ifndef GRAPHS_SERVER_H
+#define GRAPHS_SERVER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "OutputWriter.h"
+#include "EdgeIndex.h"
+#include "QueryExecutor.h"
+#include "ReachabilityIndex.h"
+#include "Reorder.h"
+#include "ThreadPool.h"
+
+/**
+ * Сервер запросов к графу через локальный сокет (Unix domain socket).
+ * Граф загружается один раз в неизменяемый снимок, поэтому запросы выполняются пулом потоков параллельно,
+ * без блокировок. Сокеты клиентов опрашивает один поток (poll) и отдает пулу по задаче на каждый запрос,
+ * так что простаивающий клиент не занимает поток. У клиента одновременно выполняется не больше одного запроса,
+ * поэтому ответы приходят в порядке запросов.
+ * Протокол текстовый, по строке на запрос и на ответ, вершины нумеруются с 1:
+ *   degree <v>        ->  OK <in> <out> (для неорграфа OK <degree>)
+ *   neighbors <v> ... ->  OK <count> <v1> <v2> ... (для пачки вершин - списки подряд, каждый со своим count)
+ *   bfs <v>, dfs <v>  ->  OK <v1> <v2> ...
+ *   path <u> <v>      ->  OK <length> <u> ... <v>, либо NONE, если пути нет
+ *   reaches <u> <v>   ->  OK 1, если из u есть путь в v, иначе OK 0
+ *   flow <s> <t>      ->  OK <value> <u1> <v1> ... (величина потока и дуги минимального разреза;
+ *                         пропускные способности - веса дуг, без весов каждая дуга пропускает 1)
+ *   degrees <v1> ...  ->  OK <d1> ... (полустепени исхода пачки вершин)
+ *   arcs <u1> <v1> ...->  OK 1/0 ... (есть ли дуги для пачки пар вершин)
+ *   shutdown          ->  OK, после чего сервер отключает клиентов и завершает работу
+ * При ошибке ответ начинается с ERR. Клиент, приславший слишком длинную строку без перевода строки,
+ * получает ERR и отключается.
+ * Снимок можно перенумеровать для локальности обращений к памяти; номера вершин в запросах и ответах при этом
+ * остаются исходными, а соседи и обходы упорядочиваются по новым номерам.
+ */
+class Server  {
+public:
+    // Пропускные способности дуг того же графа.
+    using Capacities = std::shared_ptr<const CsrGraph<uint32_t, int64_t>>;
+    // Сервер для заданного графа, вершины которого перенумеровываются способом reordering.
+    Server(QueryExecutor::Snapshot graph, bool oriented, Reordering reordering = Reordering::None,
+           Capacities capacities = nullptr);
+    // Запуск сервера, работает до запроса shutdown.
+    int Run(const std::string& path, size_t workers);
+    // Ответ на один запрос.
+    void Answer(std::string_view request, OutputWriter& response);
+private:
+    // Ответ на пакетный запрос степеней, смежных вершин или наличия дуг.
+    void AnswerBatch(std::string_view command, std::string_view request, OutputWriter& response);
+    // Состояние подключенного клиента.
+    struct Client  {
+        // Прочитанные, но еще не выполненные запросы.
+        std::string pending;
+        // Выполняется ли запрос клиента.
+        bool busy = false;
+    };
+    // Чтение данных клиента, false - клиент отключился.
+    bool Receive(int fd, Client& client);
+    // Передача пулу следующего запроса клиента, если клиент свободен.
+    void Dispatch(int fd, Client& client, ThreadPool& pool);
+    // Пробуждение потока, опрашивающего сокеты.
+    void Wake();
+    // Цикл опроса сокетов до запроса shutdown.
+    void Poll(ThreadPool& pool);
+    // Номер вершины в снимке по ее исходному номеру с 1.
+    [[nodiscard]] uint32_t ToSnapshot(size_t vertex) const;
+    // Вывод списка вершин снимка в исходных номерах с 1.
+    template<typename Range>
+    void WriteVertices(const Range& vertices, OutputWriter& response) const;
+    // Перенумерация вершин снимка.
+    Permutation<uint32_t> mOrder;
+    // Снимок графа.
+    QueryExecutor::Snapshot mGraph;
+    // Пропускные способности для запросов flow, nullptr - все дуги пропускают 1.
+    Capacities mCapacities;
+    // Ориентированность графа.
+    bool mOriented;
+    // Индекс достижимости для запросов reaches.
+    ReachabilityIndex mReachability;
+    // Хеш-индекс дуг для запросов arcs.
+    EdgeIndex<uint32_t> mEdges;
+    // Сокет, принимающий клиентов.
+    int mListener = -1;
+    // Признак остановки сервера.
+    std::atomic<bool> mStop = false;
+    // Канал, через который задачи будят опрашивающий поток.
+    int mWakeup[2] = {-1, -1};
+    // Клиенты, чьи запросы выполнены пулом с прошлого пробуждения.
+    std::vector<int> mDone;
+    std::mutex mMutex;
+};
+
+#endif //GRAPHS_SERVER_H
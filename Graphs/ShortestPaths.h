@@ -0,0 +1,260 @@
+#ifndef GRAPHS_SHORTESTPATHS_H
+#define GRAPHS_SHORTESTPATHS_H
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+// Тип расстояния для графа с весами Weight: целые веса складываются в 64-битном беззнаковом числе,
+// дробные - в double. Для невзвешенного графа расстояние - количество дуг.
+template<typename Weight>
+using DistanceType = std::conditional_t<std::is_floating_point_v<Weight>, double, uint64_t>;
+
+/**
+ * Кратчайшие пути из одной вершины: расстояния и предки вершин в дереве кратчайших путей.
+ */
+template<typename Vertex, typename Distance>
+struct ShortestPaths  {
+    // Расстояние до недостижимой вершины.
+    static constexpr Distance kInfinity = std::numeric_limits<Distance>::max();
+    // Предок источника и недостижимых вершин.
+    static constexpr Vertex kNone = std::numeric_limits<Vertex>::max();
+
+    // Расстояния от источника.
+    std::vector<Distance> distances;
+    // Предыдущая вершина на кратчайшем пути.
+    std::vector<Vertex> parents;
+
+    // Достижима ли вершина из источника.
+    [[nodiscard]] bool Reachable(Vertex v) const  {
+        return distances[v] != kInfinity;
+    }
+    /**
+     * Восстановление пути по предкам.
+     * @param to конечная вершина.
+     * @return вершины пути от источника до to, либо пустой вектор, если to недостижима.
+     */
+    [[nodiscard]] std::vector<Vertex> PathTo(Vertex to) const  {
+        std::vector<Vertex> path;
+        if (!Reachable(to))  {
+            return path;
+        }
+        for (Vertex v = to; v != kNone; v = parents[v])  {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+/**
+ * Поразрядная куча (radix heap) для монотонной очереди с приоритетом: извлекаемые ключи не убывают,
+ * а добавляемый ключ не меньше последнего извлеченного. Элемент лежит в корзине с номером старшего бита,
+ * которым его ключ отличается от последнего извлеченного, поэтому каждый элемент перекладывается
+ * не больше 64 раз, а корзины - это обычные массивы, которые читаются подряд.
+ * @tparam Value тип значения, хранимого вместе с ключом.
+ */
+template<typename Value>
+class RadixHeap  {
+public:
+    // Добавление элемента, ключ не меньше последнего извлеченного.
+    void Push(uint64_t key, Value value)  {
+        mBuckets[Bucket(key)].emplace_back(key, value);
+        ++mSize;
+    }
+    // Извлечение элемента с минимальным ключом.
+    std::pair<uint64_t, Value> Pop()  {
+        if (mBuckets[0].empty())  {
+            size_t i = 1;
+            while (mBuckets[i].empty())  {
+                ++i;
+            }
+            mLast = std::min_element(mBuckets[i].begin(), mBuckets[i].end())->first;
+            // Все элементы корзины i отличаются от нового минимума в младших битах и попадают в корзины меньше i.
+            for (auto& item : mBuckets[i])  {
+                mBuckets[Bucket(item.first)].push_back(item);
+            }
+            mBuckets[i].clear();
+        }
+        auto item = mBuckets[0].back();
+        mBuckets[0].pop_back();
+        --mSize;
+        return item;
+    }
+    // Пуста ли куча.
+    [[nodiscard]] bool Empty() const  {
+        return mSize == 0;
+    }
+
+private:
+    [[nodiscard]] size_t Bucket(uint64_t key) const  {
+        return key == mLast ? 0 : 64 - std::countl_zero(key ^ mLast);
+    }
+
+    // Корзины по номеру старшего отличающегося бита.
+    std::array<std::vector<std::pair<uint64_t, Value>>, 65> mBuckets;
+    // Последний извлеченный ключ.
+    uint64_t mLast = 0;
+    // Количество элементов.
+    size_t mSize = 0;
+};
+
+/**
+ * Ключ кучи для расстояния. Битовое представление неотрицательного double, прочитанное как целое,
+ * возрастает вместе с числом, поэтому дробные расстояния тоже можно хранить в поразрядной куче.
+ */
+template<typename Distance>
+uint64_t DistanceKey(Distance distance)  {
+    if constexpr (std::is_floating_point_v<Distance>)  {
+        return std::bit_cast<uint64_t>(distance);
+    }  else  {
+        return distance;
+    }
+}
+
+/**
+ * Алгоритм Дейкстры с поразрядной кучей. Веса дуг должны быть неотрицательными.
+ * @param graph граф в представлении CSR.
+ * @param source источник.
+ * @return расстояния и предки вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+ShortestPaths<Vertex, DistanceType<Weight>> Dijkstra(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex source)  {
+    using Distance = DistanceType<Weight>;
+    using Result = ShortestPaths<Vertex, Distance>;
+    Result result;
+    result.distances.assign(graph.Verts(), Result::kInfinity);
+    result.parents.assign(graph.Verts(), Result::kNone);
+    result.distances[source] = 0;
+    RadixHeap<Vertex> heap;
+    heap.Push(0, source);
+    while (!heap.Empty())  {
+        auto [key, v] = heap.Pop();
+        // Вершина могла быть добавлена несколько раз, актуальна только запись с текущим расстоянием.
+        if (key != DistanceKey(result.distances[v]))  {
+            continue;
+        }
+        for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+            Vertex to = graph.targets[arc];
+            Distance distance = result.distances[v] + Distance(graph.WeightOf(arc));
+            if (distance < result.distances[to])  {
+                result.distances[to] = distance;
+                result.parents[to] = v;
+                heap.Push(DistanceKey(distance), to);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Параллельный алгоритм delta-stepping. Вершины раскладываются по корзинам ширины delta и корзины
+ * обрабатываются по возрастанию. Дуги вершин текущей корзины просматриваются параллельно, каждый поток
+ * собирает свои предложения (вершина, расстояние, предок), после чего предложения применяются по порядку блоков.
+ * Поэтому результат, включая предков, не зависит от количества потоков.
+ * Легкие дуги (вес не больше delta) просматриваются, пока корзина не опустеет, тяжелые - один раз после этого.
+ * Веса дуг должны быть неотрицательными.
+ * @param graph граф в представлении CSR.
+ * @param source источник.
+ * @param delta ширина корзины, 0 - максимальный вес дуги, деленный на среднюю степень вершины.
+ * @return расстояния и предки вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+ShortestPaths<Vertex, DistanceType<Weight>> DeltaStepping(const CsrGraph<Vertex, Weight, Directed>& graph,
+                                                          Vertex source, DistanceType<Weight> delta = 0)  {
+    using Distance = DistanceType<Weight>;
+    using Result = ShortestPaths<Vertex, Distance>;
+    struct Request  {
+        Vertex to;
+        Vertex parent;
+        Distance distance;
+    };
+    size_t verts = graph.Verts();
+    if (delta == Distance(0))  {
+        Distance heaviest = 1;
+        for (size_t arc = 0; arc < graph.Arcs(); ++arc)  {
+            heaviest = std::max(heaviest, Distance(graph.WeightOf(arc)));
+        }
+        size_t degree = std::max<size_t>(1, graph.Arcs() / std::max<size_t>(1, verts));
+        delta = std::max(Distance(1), heaviest / Distance(degree));
+    }
+    Result result;
+    result.distances.assign(verts, Result::kInfinity);
+    result.parents.assign(verts, Result::kNone);
+    result.distances[source] = 0;
+    std::vector<std::vector<Vertex>> buckets(1, std::vector<Vertex>{source});
+    // Отметки вершин, уже попавших в текущую фазу и в список обработанных вершин корзины.
+    std::vector<char> inFrontier(verts, 0), inSettled(verts, 0);
+    std::vector<Vertex> frontier, settled;
+    std::vector<std::vector<Request>> requests;
+    auto index = [&](Distance distance)  {
+        return size_t(distance / delta);
+    };
+    // Параллельный сбор предложений по легким или тяжелым дугам вершин и их последовательное применение.
+    auto relax = [&](const std::vector<Vertex>& vertices, bool light)  {
+        requests.assign(Parallel::ThreadCount(vertices.size()), {});
+        Parallel::For(vertices.size(), [&](size_t begin, size_t end, size_t block)  {
+            for (size_t i = begin; i < end; ++i)  {
+                Vertex v = vertices[i];
+                for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+                    Distance weight = Distance(graph.WeightOf(arc));
+                    if ((weight <= delta) != light)  {
+                        continue;
+                    }
+                    Distance distance = result.distances[v] + weight;
+                    if (distance < result.distances[graph.targets[arc]])  {
+                        requests[block].push_back({graph.targets[arc], v, distance});
+                    }
+                }
+            }
+        });
+        for (auto& block : requests)  {
+            for (auto& request : block)  {
+                if (request.distance < result.distances[request.to])  {
+                    result.distances[request.to] = request.distance;
+                    result.parents[request.to] = request.parent;
+                    size_t bucket = index(request.distance);
+                    if (buckets.size() <= bucket)  {
+                        buckets.resize(bucket + 1);
+                    }
+                    buckets[bucket].push_back(request.to);
+                }
+            }
+        }
+    };
+    for (size_t current = 0; current < buckets.size(); ++current)  {
+        settled.clear();
+        while (!buckets[current].empty())  {
+            frontier.clear();
+            // Вершина могла перейти в меньшую корзину или попасть в эту несколько раз.
+            for (Vertex v : buckets[current])  {
+                if (index(result.distances[v]) == current && !inFrontier[v])  {
+                    inFrontier[v] = 1;
+                    frontier.push_back(v);
+                    if (!inSettled[v])  {
+                        inSettled[v] = 1;
+                        settled.push_back(v);
+                    }
+                }
+            }
+            buckets[current].clear();
+            for (Vertex v : frontier)  {
+                inFrontier[v] = 0;
+            }
+            relax(frontier, true);
+        }
+        relax(settled, false);
+        for (Vertex v : settled)  {
+            inSettled[v] = 0;
+        }
+    }
+    return result;
+}
+
+#endif //GRAPHS_SHORTESTPATHS_H
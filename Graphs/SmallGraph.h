@@ -0,0 +1,206 @@
+#ifndef GRAPHS_SMALLGRAPH_H
+#define GRAPHS_SMALLGRAPH_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "CsrGraph.h"
+
+/**
+ * Граф фиксированного размера, в котором каждая строка матрицы смежности хранится битами в массиве 64-битных слов.
+ * Не использует динамическую память и может использоваться в constexpr-вычислениях.
+ * Вершины нумеруются с 0.
+ * @tparam N максимальное количество вершин.
+ */
+template<size_t N>
+class SmallGraph  {
+public:
+    // Количество 64-битных слов в строке.
+    static constexpr size_t kWords = (N + 63) / 64;
+    // Строка матрицы смежности, либо множество вершин.
+    using Row = std::array<uint64_t, kWords>;
+private:
+    // Строки матрицы смежности.
+    std::array<Row, N> mRows{};
+    // Количество вершин.
+    size_t mVerts = N;
+    // Установка бита вершины v в строке.
+    static constexpr void Set(Row& row, size_t v)  {
+        row[v / 64] |= uint64_t(1) << (v % 64);
+    }
+    // Проверка бита вершины v в строке.
+    static constexpr bool Test(const Row& row, size_t v)  {
+        return (row[v / 64] >> (v % 64)) & 1;
+    }
+    // Проверка, что в строке нет ни одной вершины.
+    static constexpr bool None(const Row& row)  {
+        for (uint64_t word : row)  {
+            if (word != 0)  {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Расширение фронта от start, visit(v, level) вызывается для каждой вершины при первом посещении.
+    template<typename Visit>
+    constexpr Row Expand(size_t start, const Visit& visit) const;
+public:
+    constexpr SmallGraph() = default;
+    // Пустой граф с заданным количеством вершин.
+    constexpr explicit SmallGraph(size_t verts) : mVerts(verts)  {}
+    // Количество вершин.
+    [[nodiscard]] constexpr size_t Verts() const  {
+        return mVerts;
+    }
+    // Добавление дуги.
+    constexpr void AddArc(size_t from, size_t to)  {
+        Set(mRows[from], to);
+    }
+    // Добавление ребра (двух дуг).
+    constexpr void AddEdge(size_t u, size_t v)  {
+        Set(mRows[u], v);
+        Set(mRows[v], u);
+    }
+    // Удаление дуги.
+    constexpr void RemoveArc(size_t from, size_t to)  {
+        mRows[from][to / 64] &= ~(uint64_t(1) << (to % 64));
+    }
+    // Проверка наличия дуги за O(1).
+    [[nodiscard]] constexpr bool HasArc(size_t from, size_t to) const  {
+        return Test(mRows[from], to);
+    }
+    // Множество вершин, смежных с v.
+    [[nodiscard]] constexpr const Row& Neighbors(size_t v) const  {
+        return mRows[v];
+    }
+    // Полустепень исхода вершины, либо степень вершины неорграфа.
+    [[nodiscard]] constexpr size_t Degree(size_t v) const  {
+        size_t degree = 0;
+        for (uint64_t word : mRows[v])  {
+            degree += std::popcount(word);
+        }
+        return degree;
+    }
+    // Полустепень захода вершины.
+    [[nodiscard]] constexpr size_t InDegree(size_t v) const  {
+        size_t degree = 0;
+        for (size_t i = 0; i < mVerts; ++i)  {
+            degree += Test(mRows[i], v);
+        }
+        return degree;
+    }
+    // Множество вершин, достижимых из start (включая ее саму).
+    [[nodiscard]] constexpr Row Reachable(size_t start) const;
+    // Расстояния от start до всех вершин, -1 для недостижимых.
+    [[nodiscard]] constexpr std::array<int, N> BFS(size_t start) const;
+    // Транзитивное замыкание графа.
+    [[nodiscard]] constexpr SmallGraph TransitiveClosure() const;
+    // Построение графа из представления CSR.
+    template<typename Vertex, typename Weight, bool Directed>
+    static SmallGraph FromCsr(const CsrGraph<Vertex, Weight, Directed>& graph);
+};
+
+/**
+ * Обход в ширину, при котором весь фронт расширяется сразу: следующий фронт - это объединение строк вершин фронта
+ * без уже посещенных вершин.
+ * @param start точка из которой начинаем обход.
+ * @param visit функция вида visit(v, level), вызываемая для каждой посещенной вершины, включая start.
+ * @return множество посещенных вершин.
+ */
+template<size_t N>
+template<typename Visit>
+constexpr typename SmallGraph<N>::Row SmallGraph<N>::Expand(size_t start, const Visit& visit) const  {
+    Row visited{}, frontier{};
+    Set(visited, start);
+    Set(frontier, start);
+    visit(start, 0);
+    for (int level = 1; !None(frontier); ++level)  {
+        Row next{};
+        for (size_t w = 0; w < kWords; ++w)  {
+            for (uint64_t bits = frontier[w]; bits != 0; bits &= bits - 1)  {
+                const Row& row = mRows[w * 64 + std::countr_zero(bits)];
+                for (size_t k = 0; k < kWords; ++k)  {
+                    next[k] |= row[k];
+                }
+            }
+        }
+        for (size_t w = 0; w < kWords; ++w)  {
+            next[w] &= ~visited[w];
+            visited[w] |= next[w];
+            for (uint64_t bits = next[w]; bits != 0; bits &= bits - 1)  {
+                visit(w * 64 + std::countr_zero(bits), level);
+            }
+        }
+        frontier = next;
+    }
+    return visited;
+}
+
+/**
+ * Расстояния от start до всех вершин.
+ * @param start точка из которой начинаем обход.
+ * @return расстояния от start до всех вершин, -1 для недостижимых.
+ */
+template<size_t N>
+constexpr std::array<int, N> SmallGraph<N>::BFS(size_t start) const  {
+    std::array<int, N> distance{};
+    distance.fill(-1);
+    Expand(start, [&](size_t v, int level)  {
+        distance[v] = level;
+    });
+    return distance;
+}
+
+/**
+ * Множество вершин, достижимых из start.
+ * @param start точка из которой начинаем обход.
+ * @return множество достижимых вершин, включая start.
+ */
+template<size_t N>
+constexpr typename SmallGraph<N>::Row SmallGraph<N>::Reachable(size_t start) const  {
+    return Expand(start, [](size_t, int)  {});
+}
+
+/**
+ * Транзитивное замыкание алгоритмом Уоршелла, в котором строка обновляется целыми словами:
+ * если из i есть путь в k, то из i есть путь во все вершины, достижимые из k.
+ * @return граф, в котором есть дуга (u, v), если в исходном графе есть путь из u в v.
+ */
+template<size_t N>
+constexpr SmallGraph<N> SmallGraph<N>::TransitiveClosure() const  {
+    SmallGraph closure = *this;
+    for (size_t k = 0; k < mVerts; ++k)  {
+        for (size_t i = 0; i < mVerts; ++i)  {
+            if (Test(closure.mRows[i], k))  {
+                for (size_t w = 0; w < kWords; ++w)  {
+                    closure.mRows[i][w] |= closure.mRows[k][w];
+                }
+            }
+        }
+    }
+    return closure;
+}
+
+/**
+ * Построение графа из представления CSR. Если вершин больше N, бросается std::invalid_argument.
+ * @param graph граф в представлении CSR.
+ * @return граф фиксированного размера.
+ */
+template<size_t N>
+template<typename Vertex, typename Weight, bool Directed>
+SmallGraph<N> SmallGraph<N>::FromCsr(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    if (graph.Verts() > N)  {
+        throw std::invalid_argument("SmallGraph: too many vertices");
+    }
+    SmallGraph small(graph.Verts());
+    for (size_t v = 0; v < graph.Verts(); ++v)  {
+        for (Vertex to : graph.Neighbors(Vertex(v)))  {
+            small.AddArc(v, size_t(to));
+        }
+    }
+    return small;
+}
+
+#endif //GRAPHS_SMALLGRAPH_H
@@ -0,0 +1,232 @@
+#ifndef GRAPHS_SPANNINGFOREST_H
+#define GRAPHS_SPANNINGFOREST_H
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <tuple>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "CsrGraph.h"
+#include "Parallel.h"
+#include "ShortestPaths.h"
+
+/**
+ * Система непересекающихся множеств, которую можно изменять из многих потоков без блокировок.
+ * Корень с большим номером подвешивается к корню с меньшим сравнением с обменом, поэтому циклов не возникает,
+ * а сжатие путей делением пополам лишь ускоряет поиск и не мешает другим потокам.
+ */
+template<typename Vertex>
+class ConcurrentDisjointSets  {
+public:
+    // Каждая вершина в своем множестве.
+    explicit ConcurrentDisjointSets(size_t verts) : mParent(verts)  {
+        for (size_t v = 0; v < verts; ++v)  {
+            mParent[v] = Vertex(v);
+        }
+    }
+    // Корень множества вершины.
+    Vertex Find(Vertex v)  {
+        while (true)  {
+            Vertex parent = Parent(v);
+            if (parent == v)  {
+                return v;
+            }
+            Vertex grandparent = Parent(parent);
+            std::atomic_ref<Vertex>(mParent[v]).compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            v = grandparent;
+        }
+    }
+    // Объединение множеств, true - если вершины были в разных множествах.
+    bool Unite(Vertex a, Vertex b)  {
+        while (true)  {
+            a = Find(a);
+            b = Find(b);
+            if (a == b)  {
+                return false;
+            }
+            if (a < b)  {
+                std::swap(a, b);
+            }
+            // Корень a мог перестать быть корнем, тогда попытка повторяется.
+            Vertex expected = a;
+            if (std::atomic_ref<Vertex>(mParent[a]).compare_exchange_strong(expected, b, std::memory_order_acq_rel))  {
+                return true;
+            }
+        }
+    }
+
+private:
+    Vertex Parent(Vertex v)  {
+        return std::atomic_ref<Vertex>(mParent[v]).load(std::memory_order_acquire);
+    }
+
+    // Предок каждой вершины, у корня - она сама.
+    std::vector<Vertex> mParent;
+};
+
+/**
+ * Минимальный остовный лес: ребра и их суммарный вес (для невзвешенного графа - количество ребер).
+ */
+template<typename Vertex, typename Weight>
+struct SpanningForest  {
+    std::vector<Edge<Vertex, Weight>> edges;
+    DistanceType<Weight> total = 0;
+};
+
+/**
+ * Поразрядная сортировка ребер по весу (LSD по байтам). Вес переводится в беззнаковый ключ, порядок которого
+ * совпадает с порядком весов: у знаковых чисел инвертируется знаковый бит, у дробных - все биты отрицательных
+ * чисел и знаковый бит неотрицательных. Сортировка устойчива, ребра с равными весами сохраняют порядок.
+ * @param edges ребра.
+ */
+template<typename Vertex, typename Weight>
+void RadixSortByWeight(std::vector<Edge<Vertex, Weight>>& edges)  {
+    if constexpr (!std::is_void_v<Weight>)  {
+        using Key = std::conditional_t<sizeof(Weight) <= 4, uint32_t, uint64_t>;
+        auto key = [](Weight weight)  {
+            if constexpr (std::is_floating_point_v<Weight>)  {
+                Key bits = std::bit_cast<Key>(weight);
+                constexpr Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+                return (bits & sign) ? Key(~bits) : Key(bits | sign);
+            }  else if constexpr (std::is_signed_v<Weight>)  {
+                return Key(std::make_unsigned_t<Weight>(weight)) ^ (Key(1) << (sizeof(Weight) * 8 - 1));
+            }  else  {
+                return Key(weight);
+            }
+        };
+        std::vector<Edge<Vertex, Weight>> buffer(edges.size());
+        for (size_t shift = 0; shift < sizeof(Weight) * 8; shift += 8)  {
+            std::array<size_t, 257> count{};
+            for (auto& edge : edges)  {
+                ++count[((key(edge.weight) >> shift) & 0xff) + 1];
+            }
+            for (size_t digit = 0; digit < 256; ++digit)  {
+                count[digit + 1] += count[digit];
+            }
+            for (auto& edge : edges)  {
+                buffer[count[(key(edge.weight) >> shift) & 0xff]++] = edge;
+            }
+            std::swap(edges, buffer);
+        }
+    }
+}
+
+/**
+ * Алгоритм Краскала: ребра сортируются поразрядно по весу и добавляются в лес, если соединяют разные деревья.
+ * @param verts количество вершин.
+ * @param edges ребра (например, список ребер графа), каждое ребро задается один раз.
+ * @return минимальный остовный лес.
+ */
+template<typename Vertex, typename Weight>
+SpanningForest<Vertex, Weight> Kruskal(size_t verts, std::vector<Edge<Vertex, Weight>> edges)  {
+    RadixSortByWeight(edges);
+    ConcurrentDisjointSets<Vertex> sets(verts);
+    SpanningForest<Vertex, Weight> forest;
+    for (auto& edge : edges)  {
+        if (sets.Unite(edge.from, edge.to))  {
+            forest.edges.push_back(edge);
+            if constexpr (std::is_void_v<Weight>)  {
+                ++forest.total;
+            }  else  {
+                forest.total += DistanceType<Weight>(edge.weight);
+            }
+        }
+    }
+    return forest;
+}
+
+// Алгоритм Краскала для неорграфа в представлении CSR, каждое ребро берется один раз.
+template<typename Vertex, typename Weight>
+SpanningForest<Vertex, Weight> Kruskal(const CsrGraph<Vertex, Weight, false>& graph)  {
+    std::vector<Edge<Vertex, Weight>> edges;
+    for (size_t v = 0; v < graph.Verts(); ++v)  {
+        for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+            if (v < graph.targets[arc])  {
+                if constexpr (std::is_void_v<Weight>)  {
+                    edges.push_back({Vertex(v), graph.targets[arc]});
+                }  else  {
+                    edges.push_back({Vertex(v), graph.targets[arc], graph.weights[arc]});
+                }
+            }
+        }
+    }
+    return Kruskal(graph.Verts(), std::move(edges));
+}
+
+/**
+ * Параллельный алгоритм Борувки. На каждом раунде для каждой компоненты параллельно выбирается самое легкое
+ * выходящее из нее ребро (атомарный минимум сравнением с обменом), затем выбранные ребра параллельно объединяют
+ * компоненты в ConcurrentDisjointSets. Ребра сравниваются по (весу, меньшему концу, большему концу),
+ * это строгий порядок, поэтому выбранные ребра не образуют циклов. Раундов не больше log V.
+ * @param graph неорграф в представлении CSR.
+ * @return минимальный остовный лес.
+ */
+template<typename Vertex, typename Weight>
+SpanningForest<Vertex, Weight> Boruvka(const CsrGraph<Vertex, Weight, false>& graph)  {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    size_t verts = graph.Verts();
+    std::vector<Vertex> source(graph.Arcs());
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        for (size_t v = begin; v < end; ++v)  {
+            std::fill(source.begin() + std::ptrdiff_t(graph.offsets[v]),
+                      source.begin() + std::ptrdiff_t(graph.offsets[v + 1]), Vertex(v));
+        }
+    });
+    auto lighter = [&](size_t a, size_t b)  {
+        auto ends = [&](size_t arc)  {
+            return std::minmax(source[arc], graph.targets[arc]);
+        };
+        return std::tuple(graph.WeightOf(a), ends(a)) < std::tuple(graph.WeightOf(b), ends(b));
+    };
+    ConcurrentDisjointSets<Vertex> sets(verts);
+    std::vector<size_t> lightest(verts);
+    std::vector<std::vector<size_t>> chosen;
+    SpanningForest<Vertex, Weight> forest;
+    while (true)  {
+        std::fill(lightest.begin(), lightest.end(), none);
+        Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+            for (size_t v = begin; v < end; ++v)  {
+                Vertex root = sets.Find(Vertex(v));
+                std::atomic_ref<size_t> best(lightest[root]);
+                for (size_t arc = graph.offsets[v]; arc < graph.offsets[v + 1]; ++arc)  {
+                    if (sets.Find(graph.targets[arc]) == root)  {
+                        continue;
+                    }
+                    size_t current = best.load(std::memory_order_relaxed);
+                    while ((current == none || lighter(arc, current)) &&
+                           !best.compare_exchange_weak(current, arc, std::memory_order_relaxed))  {}
+                }
+            }
+        });
+        chosen.assign(Parallel::ThreadCount(verts), {});
+        Parallel::For(verts, [&](size_t begin, size_t end, size_t block)  {
+            for (size_t c = begin; c < end; ++c)  {
+                size_t arc = lightest[c];
+                if (arc != none && sets.Unite(source[arc], graph.targets[arc]))  {
+                    chosen[block].push_back(arc);
+                }
+            }
+        });
+        size_t before = forest.edges.size();
+        for (auto& block : chosen)  {
+            for (size_t arc : block)  {
+                if constexpr (std::is_void_v<Weight>)  {
+                    forest.edges.push_back({source[arc], graph.targets[arc]});
+                    ++forest.total;
+                }  else  {
+                    forest.edges.push_back({source[arc], graph.targets[arc], graph.weights[arc]});
+                    forest.total += DistanceType<Weight>(graph.weights[arc]);
+                }
+            }
+        }
+        if (forest.edges.size() == before)  {
+            return forest;
+        }
+    }
+}
+
+#endif //GRAPHS_SPANNINGFOREST_H
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include "Parallel.h"
+#include "ThreadPool.h"
+
+/**
+ * Конструктор, запускающий рабочие потоки.
+ * @param threads количество потоков, 0 - по числу ядер процессора.
+ */
+ThreadPool::ThreadPool(size_t threads)  {
+    if (threads == 0)  {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threads; ++i)  {
+        mQueues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threads; ++i)  {
+        mWorkers.emplace_back(&ThreadPool::Run, this, i);
+    }
+}
+
+/**
+ * Деструктор дожидается выполнения всех задач и останавливает потоки.
+ */
+ThreadPool::~ThreadPool()  {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mNotEmpty.notify_all();
+    for (auto& worker : mWorkers)  {
+        worker.join();
+    }
+}
+
+/**
+ * Добавление задачи. Из рабочего потока задача кладется в конец его очереди, т.к. скорее всего
+ * работает с теми же данными, что и текущая, иначе - в очередь следующего по кругу потока.
+ * @param task задача.
+ */
+void ThreadPool::Submit(std::function<void()> task)  {
+    size_t index = tPool == this ? tIndex : mNext++ % mQueues.size();
+    // Счетчик увеличивается до публикации задачи: иначе другой поток может забрать ее и уменьшить счетчик
+    // раньше, и он на мгновение переполнится вниз.
+    ++mPending;
+    {
+        std::lock_guard<std::mutex> lock(mQueues[index]->mutex);
+        mQueues[index]->tasks.push_back(std::move(task));
+    }
+    // Захват мьютекса гарантирует, что поток, проверяющий mPending перед ожиданием, не пропустит оповещение.
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+    }
+    mNotEmpty.notify_one();
+}
+
+/**
+ * Количество потоков пула.
+ * @return количество потоков.
+ */
+size_t ThreadPool::Size() const  {
+    return mWorkers.size();
+}
+
+/**
+ * Выполнение одной ожидающей задачи в вызывающем потоке. Используется ожидающими, чтобы помогать пулу.
+ * @return true, если задача была найдена и выполнена, иначе false.
+ */
+bool ThreadPool::RunPendingTask()  {
+    std::function<void()> task;
+    if (!TryPop(tPool == this ? tIndex : 0, task))  {
+        return false;
+    }
+    task();
+    return true;
+}
+
+/**
+ * Общий пул для параллельных алгоритмов. Количество потоков берется из Parallel::sThreads
+ * в момент первого обращения.
+ * @return общий пул.
+ */
+ThreadPool& ThreadPool::Global()  {
+    static ThreadPool pool(Parallel::sThreads);
+    return pool;
+}
+
+/**
+ * Поиск задачи: сначала из конца своей очереди, затем из начала очередей остальных потоков.
+ * @param index номер потока.
+ * @param task найденная задача.
+ * @return true, если задача найдена, иначе false.
+ */
+bool ThreadPool::TryPop(size_t index, std::function<void()>& task)  {
+    for (size_t i = 0; i < mQueues.size(); ++i)  {
+        Queue& queue = *mQueues[(index + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())  {
+            continue;
+        }
+        if (i == 0)  {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }  else  {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --mPending;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Функция рабочего потока: выполняет задачи, пока пул не остановлен и задачи не закончились.
+ * @param index номер потока.
+ */
+void ThreadPool::Run(size_t index)  {
+    tPool = this;
+    tIndex = index;
+    std::function<void()> task;
+    while (true)  {
+        if (TryPop(index, task))  {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [this]  {
+            return mPending > 0 || mStop;
+        });
+        if (mStop && mPending == 0)  {
+            return;
+        }
+    }
+}
+
+/**
+ * Конструктор группы задач.
+ * @param pool пул, в котором будут выполняться задачи.
+ */
+TaskGroup::TaskGroup(ThreadPool& pool) : mPool(pool)  {}
+
+/**
+ * Деструктор дожидается завершения всех задач группы, т.к. они могут ссылаться на данные вызывающего.
+ */
+TaskGroup::~TaskGroup()  {
+    Join();
+}
+
+/**
+ * Ожидание задач группы. Пока в пуле есть ожидающие задачи, вызывающий поток выполняет их (в том числе задачи
+ * этой группы). Когда их нет, все незавершенные задачи группы уже выполняются другими потоками, и вызывающий
+ * засыпает до завершения последней из них.
+ */
+void TaskGroup::Join()  {
+    while (mActive > 0)  {
+        if (!mPool.RunPendingTask())  {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mFinished.wait(lock, [this]  {
+                return mActive == 0;
+            });
+        }
+    }
+}
+
+/**
+ * Порождение задачи группы.
+ * @param task задача.
+ */
+void TaskGroup::Spawn(std::function<void()> task)  {
+    ++mActive;
+    mPool.Submit([this, task = std::move(task)]  {
+        try  {
+            task();
+        }  catch(...)  {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mError)  {
+                mError = std::current_exception();
+            }
+        }
+        // Уменьшение под мьютексом: ожидающий не может проснуться и уничтожить группу, пока оповещение
+        // не отправлено.
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mActive == 0)  {
+            mFinished.notify_all();
+        }
+    });
+}
+
+/**
+ * Ожидание завершения всех задач группы (см. Join). Первое исключение, выброшенное задачей, пробрасывается.
+ */
+void TaskGroup::Wait()  {
+    Join();
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mError)  {
+        std::exception_ptr error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
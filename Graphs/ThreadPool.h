@@ -0,0 +1,109 @@
+#ifndef GRAPHS_THREADPOOL_H
+#define GRAPHS_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Пул потоков с перехватом работы (work stealing): у каждого потока своя очередь задач.
+ * Поток берет задачи из конца своей очереди, а когда она пуста - из начала очередей других потоков.
+ * Задачи, добавленные из рабочего потока, попадают в его же очередь, а добавленные извне
+ * распределяются по очередям по кругу.
+ */
+class ThreadPool  {
+public:
+    // Запуск пула, 0 потоков - по числу ядер процессора.
+    explicit ThreadPool(size_t threads = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // Дожидается выполнения всех задач и останавливает потоки.
+    ~ThreadPool();
+    // Добавление задачи.
+    void Submit(std::function<void()> task);
+    // Количество потоков пула.
+    [[nodiscard]] size_t Size() const;
+    // Выполнение одной ожидающей задачи в вызывающем потоке.
+    bool RunPendingTask();
+    // Общий пул для параллельных алгоритмов, создается при первом обращении.
+    static ThreadPool& Global();
+private:
+    // Очередь задач одного потока.
+    struct Queue  {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    // Поиск задачи: сначала в своей очереди, потом в чужих.
+    bool TryPop(size_t index, std::function<void()>& task);
+    // Функция рабочего потока.
+    void Run(size_t index);
+    // Очереди задач потоков.
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    // Номер очереди для следующей задачи, добавленной извне.
+    std::atomic<size_t> mNext = 0;
+    // Количество задач, которые еще не взяты на выполнение.
+    std::atomic<size_t> mPending = 0;
+    // Признак остановки пула.
+    bool mStop = false;
+    std::mutex mMutex;
+    // Оповещение простаивающих потоков о новой задаче или остановке.
+    std::condition_variable mNotEmpty;
+    // Рабочие потоки.
+    std::vector<std::thread> mWorkers;
+    // Пул, которому принадлежит текущий поток, и номер потока в нем.
+    inline static thread_local ThreadPool* tPool = nullptr;
+    inline static thread_local size_t tIndex = 0;
+};
+
+/**
+ * Группа задач для параллелизма вида fork/join: задачи порождаются в пуле, а ожидающий их поток
+ * не простаивает, а сам выполняет ожидающие задачи пула. Поэтому ожидать группу можно и из задачи,
+ * в том числе рекурсивно, не рискуя занять все потоки ожиданием.
+ * Первое исключение, выброшенное задачей, пробрасывается из Wait.
+ */
+class TaskGroup  {
+public:
+    // Группа задач в пуле pool.
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::Global());
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    // Дожидается завершения всех задач группы.
+    ~TaskGroup();
+    // Порождение задачи.
+    void Spawn(std::function<void()> task);
+    // Ожидание завершения всех задач группы.
+    void Wait();
+private:
+    // Выполнение задач пула, пока они есть, затем ожидание завершения задач группы.
+    void Join();
+    // Пул потоков.
+    ThreadPool& mPool;
+    // Количество незавершенных задач.
+    std::atomic<size_t> mActive = 0;
+    // Первое исключение, выброшенное задачей.
+    std::exception_ptr mError;
+    std::mutex mMutex;
+    // Оповещение ожидающего о завершении последней задачи.
+    std::condition_variable mFinished;
+};
+
+/**
+ * Параллельное выполнение двух функций: первая порождается задачей, вторая выполняется в вызывающем потоке.
+ * @param first первая функция.
+ * @param second вторая функция.
+ */
+template<typename First, typename Second>
+void ForkJoin(First&& first, Second&& second)  {
+    TaskGroup group;
+    group.Spawn(std::forward<First>(first));
+    second();
+    group.Wait();
+}
+
+#endif //GRAPHS_THREADPOOL_H
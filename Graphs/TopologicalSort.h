@@ -0,0 +1,95 @@
+#ifndef GRAPHS_TOPOLOGICALSORT_H
+#define GRAPHS_TOPOLOGICALSORT_H
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+/**
+ * Результат топологической сортировки: порядок вершин, либо цикл, если граф не ацикличен.
+ */
+template<typename Vertex>
+struct TopologicalOrder  {
+    // Вершины в топологическом порядке (для графа с циклом - только те, что удалось упорядочить).
+    std::vector<Vertex> order;
+    // Цикл c0 -> c1 -> ... -> c0 (последняя дуга ведет в c0), пустой для ациклического графа.
+    std::vector<Vertex> cycle;
+
+    // Ацикличен ли граф.
+    [[nodiscard]] bool IsDag() const  {
+        return cycle.empty();
+    }
+};
+
+/**
+ * Топологическая сортировка алгоритмом Кана по уровням. Фронт - вершины с нулевой полустепенью захода -
+ * обрабатывается параллельно блоками: каждая дуга уменьшает атомарный счетчик полустепени конца, и вершина,
+ * счетчик которой обнулился, попадает в следующий фронт своего блока. Следующий фронт упорядочивается по номерам,
+ * поэтому порядок не зависит от количества потоков. Если упорядочены не все вершины, у каждой оставшейся есть
+ * входящая дуга из оставшейся, и цикл находится проходом назад по таким дугам.
+ * Нужны входящие дуги (BuildIncoming).
+ * @param graph орграф в представлении CSR.
+ * @return топологический порядок или цикл.
+ */
+template<typename Vertex, typename Weight>
+TopologicalOrder<Vertex> TopologicalSort(const CsrGraph<Vertex, Weight, true>& graph)  {
+    size_t verts = graph.Verts();
+    TopologicalOrder<Vertex> result;
+    result.order.reserve(verts);
+    std::vector<size_t> inDegree(verts);
+    std::vector<Vertex> frontier;
+    for (size_t v = 0; v < verts; ++v)  {
+        inDegree[v] = graph.InDegree(Vertex(v));
+        if (inDegree[v] == 0)  {
+            frontier.push_back(Vertex(v));
+        }
+    }
+    std::vector<std::vector<Vertex>> next;
+    while (!frontier.empty())  {
+        result.order.insert(result.order.end(), frontier.begin(), frontier.end());
+        next.assign(Parallel::ThreadCount(frontier.size()), {});
+        Parallel::For(frontier.size(), [&](size_t begin, size_t end, size_t block)  {
+            for (size_t i = begin; i < end; ++i)  {
+                for (Vertex to : graph.Neighbors(frontier[i]))  {
+                    if (std::atomic_ref<size_t>(inDegree[to]).fetch_sub(1, std::memory_order_relaxed) == 1)  {
+                        next[block].push_back(to);
+                    }
+                }
+            }
+        });
+        frontier.clear();
+        for (auto& part : next)  {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+        }
+        std::sort(frontier.begin(), frontier.end());
+    }
+    if (result.order.size() == verts)  {
+        return result;
+    }
+    // Проход назад по входящим дугам из неупорядоченных вершин, пока вершина не повторится.
+    std::vector<char> ordered(verts, 0);
+    for (Vertex v : result.order)  {
+        ordered[v] = 1;
+    }
+    constexpr size_t none = size_t(-1);
+    std::vector<size_t> step(verts, none);
+    Vertex v = Vertex(std::find(ordered.begin(), ordered.end(), 0) - ordered.begin());
+    std::vector<Vertex> walk;
+    while (step[v] == none)  {
+        step[v] = walk.size();
+        walk.push_back(v);
+        for (Vertex from : graph.InNeighbors(v))  {
+            if (!ordered[from])  {
+                v = from;
+                break;
+            }
+        }
+    }
+    // Путь назад от повторившейся вершины, развернутый, - цикл по направлению дуг.
+    result.cycle.assign(walk.rbegin(), walk.rend() - std::ptrdiff_t(step[v]));
+    return result;
+}
+
+#endif //GRAPHS_TOPOLOGICALSORT_H
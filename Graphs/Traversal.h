@@ -0,0 +1,213 @@
+#ifndef GRAPHS_TRAVERSAL_H
+#define GRAPHS_TRAVERSAL_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "CsrGraph.h"
+
+/**
+ * Обход в ширину по графу в представлении CSR. Граф не изменяется, поэтому обходы можно выполнять параллельно.
+ * После компоненты вершины start остальные вершины обходятся по мере возрастания номеров, как и в Graph.
+ * @param graph граф в представлении CSR.
+ * @param start точка из которой начинаем обход.
+ * @return порядок обхода вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+std::vector<Vertex> BfsTraversal(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex start)  {
+    size_t verts = graph.Verts();
+    std::vector<Vertex> order;
+    order.reserve(verts);
+    std::vector<char> visited(verts, 0);
+    for (size_t root = 0; root <= verts; ++root)  {
+        Vertex source = root == 0 ? start : Vertex(root - 1);
+        if (source >= verts || visited[source])  {
+            continue;
+        }
+        visited[source] = 1;
+        // Очередь - это конец массива order, начиная с позиции head.
+        size_t head = order.size();
+        order.push_back(source);
+        while (head < order.size())  {
+            for (Vertex to : graph.Neighbors(order[head++]))  {
+                if (!visited[to])  {
+                    visited[to] = 1;
+                    order.push_back(to);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * Нерекурсивный обход в глубину по графу в представлении CSR. Порядок совпадает с рекурсивным обходом:
+ * для каждой вершины хранится позиция следующей непросмотренной дуги.
+ * После компоненты вершины start остальные вершины обходятся по мере возрастания номеров.
+ * @param graph граф в представлении CSR.
+ * @param start точка из которой начинаем обход.
+ * @return порядок обхода вершин.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+std::vector<Vertex> DfsTraversal(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex start)  {
+    size_t verts = graph.Verts();
+    std::vector<Vertex> order;
+    order.reserve(verts);
+    std::vector<char> visited(verts, 0);
+    // Стек пар (вершина, индекс следующей дуги).
+    std::vector<std::pair<Vertex, size_t>> stack;
+    for (size_t root = 0; root <= verts; ++root)  {
+        Vertex source = root == 0 ? start : Vertex(root - 1);
+        if (source >= verts || visited[source])  {
+            continue;
+        }
+        visited[source] = 1;
+        order.push_back(source);
+        stack.emplace_back(source, graph.offsets[source]);
+        while (!stack.empty())  {
+            auto& [v, arc] = stack.back();
+            if (arc == graph.offsets[v + 1])  {
+                stack.pop_back();
+                continue;
+            }
+            Vertex to = graph.targets[arc++];
+            if (!visited[to])  {
+                visited[to] = 1;
+                order.push_back(to);
+                stack.emplace_back(to, graph.offsets[to]);
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * Кратчайший по количеству дуг путь из from в to, найденный двунаправленным обходом в ширину:
+ * один обход идет по дугам из from, другой - против дуг из to. Каждый раз на один уровень продвигается обход
+ * с меньшим фронтом, и поиск заканчивается, как только обходы встретились. Первая же встреча дает кратчайший путь:
+ * до нее шары обходов не пересекались, поэтому путь не короче суммы их радиусов плюс одна дуга.
+ * Для орграфа нужны входящие дуги (BuildIncoming).
+ * @param graph граф в представлении CSR.
+ * @param from начало пути.
+ * @param to конец пути.
+ * @return вершины пути от from до to (длина пути - количество вершин минус 1), либо пустой вектор, если пути нет.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+std::vector<Vertex> ShortestPath(const CsrGraph<Vertex, Weight, Directed>& graph, Vertex from, Vertex to)  {
+    constexpr Vertex none = std::numeric_limits<Vertex>::max();
+    if (from == to)  {
+        return {from};
+    }
+    // Соседняя вершина на пути к from для прямого обхода и на пути к to для обратного.
+    std::vector<Vertex> forward(graph.Verts(), none), backward(graph.Verts(), none);
+    forward[from] = from;
+    backward[to] = to;
+    std::vector<Vertex> forwardFrontier = {from}, backwardFrontier = {to}, next;
+    Vertex meet = none;
+    while (meet == none && !forwardFrontier.empty() && !backwardFrontier.empty())  {
+        bool isForward = forwardFrontier.size() <= backwardFrontier.size();
+        auto& frontier = isForward ? forwardFrontier : backwardFrontier;
+        auto& own = isForward ? forward : backward;
+        auto& other = isForward ? backward : forward;
+        next.clear();
+        for (size_t i = 0; i < frontier.size() && meet == none; ++i)  {
+            for (Vertex u : isForward ? graph.Neighbors(frontier[i]) : graph.InNeighbors(frontier[i]))  {
+                if (own[u] != none)  {
+                    continue;
+                }
+                own[u] = frontier[i];
+                if (other[u] != none)  {
+                    meet = u;
+                    break;
+                }
+                next.push_back(u);
+            }
+        }
+        std::swap(frontier, next);
+    }
+    std::vector<Vertex> path;
+    if (meet == none)  {
+        return path;
+    }
+    for (Vertex v = meet; v != from; v = forward[v])  {
+        path.push_back(v);
+    }
+    path.push_back(from);
+    std::reverse(path.begin(), path.end());
+    for (Vertex v = meet; v != to; )  {
+        v = backward[v];
+        path.push_back(v);
+    }
+    return path;
+}
+
+/**
+ * Раскраска вершин в два цвета так, чтобы концы каждого ребра были разного цвета, либо нечетный цикл,
+ * доказывающий, что такой раскраски нет.
+ */
+template<typename Vertex>
+struct TwoColoring  {
+    // Цвет вершины, 0 или 1.
+    std::vector<char> color;
+    // Нечетный цикл c0 - c1 - ... - c0, пустой для двудольного графа.
+    std::vector<Vertex> oddCycle;
+
+    // Двудолен ли граф.
+    [[nodiscard]] bool IsBipartite() const  {
+        return oddCycle.empty();
+    }
+};
+
+/**
+ * Проверка двудольности обходом в ширину: вершины каждого уровня получают цвет, противоположный цвету
+ * предыдущего уровня. Ребро между вершинами одного цвета вместе с путями до их общего предка в дереве обхода
+ * дает нечетный цикл. Направления дуг не учитываются, граф должен быть неориентированным.
+ * @param graph неорграф в представлении CSR.
+ * @return раскраска или нечетный цикл.
+ */
+template<typename Vertex, typename Weight>
+TwoColoring<Vertex> BipartiteColoring(const CsrGraph<Vertex, Weight, false>& graph)  {
+    size_t verts = graph.Verts();
+    TwoColoring<Vertex> result;
+    result.color.assign(verts, 0);
+    std::vector<Vertex> parent(verts), queue;
+    std::vector<size_t> depth(verts, std::numeric_limits<size_t>::max());
+    for (size_t root = 0; root < verts; ++root)  {
+        if (depth[root] != std::numeric_limits<size_t>::max())  {
+            continue;
+        }
+        depth[root] = 0;
+        parent[root] = Vertex(root);
+        queue.assign(1, Vertex(root));
+        for (size_t head = 0; head < queue.size(); ++head)  {
+            Vertex v = queue[head];
+            for (Vertex to : graph.Neighbors(v))  {
+                if (depth[to] == std::numeric_limits<size_t>::max())  {
+                    depth[to] = depth[v] + 1;
+                    parent[to] = v;
+                    result.color[to] = char(1 - result.color[v]);
+                    queue.push_back(to);
+                }  else if (result.color[to] == result.color[v])  {
+                    // Подъем по дереву от обоих концов до общего предка.
+                    std::vector<Vertex> tail = {to};
+                    Vertex a = v, b = to;
+                    result.oddCycle.push_back(v);
+                    while (a != b)  {
+                        if (depth[a] >= depth[b])  {
+                            a = parent[a];
+                            result.oddCycle.push_back(a);
+                        }  else  {
+                            b = parent[b];
+                            tail.push_back(b);
+                        }
+                    }
+                    result.oddCycle.insert(result.oddCycle.end(), tail.rbegin() + 1, tail.rend());
+                    return result;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+#endif //GRAPHS_TRAVERSAL_H
@@ -0,0 +1,202 @@
+#ifndef GRAPHS_TRIANGLES_H
+#define GRAPHS_TRIANGLES_H
+
+#include <vector>
+#include <span>
+#include <bit>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Треугольники графа и коэффициенты кластеризации. Граф рассматривается как простой неориентированный:
+ * направления дуг, петли и кратные дуги не учитываются.
+ */
+struct TriangleStats  {
+    // Количество треугольников, в которые входит каждая вершина.
+    std::vector<uint64_t> perVertex;
+    // Локальный коэффициент кластеризации: доля пар соседей вершины, соединенных ребром.
+    std::vector<double> clustering;
+    // Общее количество треугольников.
+    uint64_t total = 0;
+    // Средний локальный коэффициент кластеризации.
+    double averageClustering = 0;
+    // Глобальный коэффициент кластеризации: 3 * треугольники / количество путей из двух ребер.
+    double transitivity = 0;
+};
+
+/**
+ * Пересечение двух возрастающих списков без повторов слиянием. С SSE2 списки сравниваются блоками по 4 элемента:
+ * блок a сравнивается со всеми четырьмя циклическими сдвигами блока b, после чего продвигается блок
+ * с меньшим последним элементом. Хвосты сливаются поэлементно.
+ * @param a, b списки.
+ * @param match функция, вызываемая для каждого общего элемента.
+ */
+template<typename Vertex, typename Func>
+void IntersectSorted(std::span<const Vertex> a, std::span<const Vertex> b, const Func& match)  {
+    size_t i = 0, j = 0;
+#if defined(__SSE2__)
+    if constexpr (sizeof(Vertex) == 4)  {
+        while (i + 4 <= a.size() && j + 4 <= b.size())  {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+            __m128i equal = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+                    _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)),
+                                 _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+            for (unsigned mask = unsigned(_mm_movemask_ps(_mm_castsi128_ps(equal))); mask != 0; mask &= mask - 1)  {
+                match(a[i + std::countr_zero(mask)]);
+            }
+            Vertex lastA = a[i + 3], lastB = b[j + 3];
+            if (lastA <= lastB)  {
+                i += 4;
+            }
+            if (lastB <= lastA)  {
+                j += 4;
+            }
+        }
+    }
+#endif
+    while (i < a.size() && j < b.size())  {
+        if (a[i] < b[j])  {
+            ++i;
+        }  else if (b[j] < a[i])  {
+            ++j;
+        }  else  {
+            match(a[i]);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+/**
+ * Подсчет треугольников. Вершины упорядочиваются по степени, и каждое ребро направляется от меньшей вершины
+ * к большей, так что у каждой вершины остается O(sqrt(E)) исходящих ребер. Треугольник (r, s, w), где r < s < w,
+ * находится один раз - пересечением отсортированных списков r и s. Вершины обрабатываются параллельно блоками.
+ * @param graph граф в представлении CSR.
+ * @return количество треугольников и коэффициенты кластеризации.
+ */
+template<typename Vertex, typename Weight, bool Directed>
+TriangleStats CountTriangles(const CsrGraph<Vertex, Weight, Directed>& graph)  {
+    size_t verts = graph.Verts();
+    // Степени в простом неорграфе: смежные вершины без направления, петель и повторов.
+    auto simpleNeighbors = [&](Vertex v, std::vector<Vertex>& list)  {
+        list.clear();
+        for (Vertex u : graph.Neighbors(v))  {
+            list.push_back(u);
+        }
+        if constexpr (Directed)  {
+            for (Vertex u : graph.InNeighbors(v))  {
+                list.push_back(u);
+            }
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        list.erase(std::remove(list.begin(), list.end(), v), list.end());
+    };
+    std::vector<size_t> degree(verts);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        std::vector<Vertex> list;
+        for (size_t v = begin; v < end; ++v)  {
+            simpleNeighbors(Vertex(v), list);
+            degree[v] = list.size();
+        }
+    });
+    // Ранг вершины - позиция в порядке возрастания степени, при равных степенях - номера (сортировка подсчетом).
+    size_t maxDegree = verts == 0 ? 0 : *std::max_element(degree.begin(), degree.end());
+    std::vector<size_t> start(maxDegree + 2, 0);
+    for (size_t d : degree)  {
+        ++start[d + 1];
+    }
+    for (size_t d = 0; d <= maxDegree; ++d)  {
+        start[d + 1] += start[d];
+    }
+    std::vector<Vertex> rank(verts), order(verts);
+    for (size_t v = 0; v < verts; ++v)  {
+        rank[v] = Vertex(start[degree[v]]++);
+        order[rank[v]] = Vertex(v);
+    }
+    // Ребра от меньшего ранга к большему, списки по рангам, отсортированы.
+    CsrGraph<Vertex> dag;
+    dag.offsets.assign(verts + 1, 0);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        std::vector<Vertex> list;
+        for (size_t r = begin; r < end; ++r)  {
+            simpleNeighbors(order[r], list);
+            dag.offsets[r + 1] = std::count_if(list.begin(), list.end(), [&](Vertex u)  {
+                return rank[u] > r;
+            });
+        }
+    });
+    for (size_t r = 0; r < verts; ++r)  {
+        dag.offsets[r + 1] += dag.offsets[r];
+    }
+    dag.targets.resize(dag.offsets[verts]);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t)  {
+        std::vector<Vertex> list;
+        for (size_t r = begin; r < end; ++r)  {
+            simpleNeighbors(order[r], list);
+            size_t position = dag.offsets[r];
+            for (Vertex u : list)  {
+                if (rank[u] > r)  {
+                    dag.targets[position++] = rank[u];
+                }
+            }
+            std::sort(dag.targets.begin() + std::ptrdiff_t(dag.offsets[r]), dag.targets.begin() + std::ptrdiff_t(position));
+        }
+    });
+    TriangleStats stats;
+    stats.perVertex.assign(verts, 0);
+    std::vector<uint64_t> blockTotal(Parallel::ThreadCount(verts), 0);
+    Parallel::For(verts, [&](size_t begin, size_t end, size_t block)  {
+        auto credit = [&](Vertex r, uint64_t count)  {
+            std::atomic_ref<uint64_t>(stats.perVertex[order[r]]).fetch_add(count, std::memory_order_relaxed);
+        };
+        for (size_t r = begin; r < end; ++r)  {
+            uint64_t own = 0;
+            for (Vertex s : dag.Neighbors(Vertex(r)))  {
+                uint64_t common = 0;
+                IntersectSorted(dag.Neighbors(Vertex(r)), dag.Neighbors(s), [&](Vertex w)  {
+                    ++common;
+                    credit(w, 1);
+                });
+                if (common != 0)  {
+                    credit(s, common);
+                    own += common;
+                }
+            }
+            if (own != 0)  {
+                credit(Vertex(r), own);
+            }
+            blockTotal[block] += own;
+        }
+    });
+    uint64_t wedges = 0;
+    stats.clustering.assign(verts, 0);
+    for (size_t v = 0; v < verts; ++v)  {
+        uint64_t pairs = uint64_t(degree[v]) * (degree[v] - (degree[v] > 0)) / 2;
+        wedges += pairs;
+        if (pairs != 0)  {
+            stats.clustering[v] = double(stats.perVertex[v]) / double(pairs);
+        }
+        stats.averageClustering += stats.clustering[v];
+    }
+    for (uint64_t total : blockTotal)  {
+        stats.total += total;
+    }
+    if (verts != 0)  {
+        stats.averageClustering /= double(verts);
+    }
+    if (wedges != 0)  {
+        stats.transitivity = 3.0 * double(stats.total) / double(wedges);
+    }
+    return stats;
+}
+
+#endif //GRAPHS_TRIANGLES_H
@@ -1,11 +1,17 @@
 #include <iostream>
 #include "Menu.h"
+#include "Batch.h"
 /**
- * Точка входа программы.
+ * Точка входа программы. Без аргументов запускается меню, иначе - пакетный режим.
+ * @param argc количество аргументов командной строки.
+ * @param argv аргументы командной строки.
  * @return код завершения программы
  */
-int main()  {
+int main(int argc, char* argv[])  {
     try  {
+        if (argc > 1)  {
+            return RunBatch(argc, argv);
+        }
         Menu();
     }  catch(std::exception&)  {
         std::cout << "Something went wrong, try again!\n";